@@ -1,7 +1,31 @@
 #include "animation.h"
+#include "render.hpp"
+#include "loader.hpp"
+#include "loadtimes.hpp"
 #include <cstdlib>
 #include <vector>
 
+// Tight alpha bounds of every cell in a trimmed atlas, relative to the cell origin
+struct AtlasTrim {
+    unsigned int textureId;
+    int frameWidth;
+    int frameHeight;
+    int columns;
+    std::vector<Rectangle> bounds;
+};
+
+static std::vector<AtlasTrim> atlasTrims;
+
+static const AtlasTrim* FindAtlasTrim(Texture2D texture, const AtlasInfo& atlas)
+{
+    for (const auto& trim : atlasTrims) {
+        if (trim.textureId == texture.id && trim.frameWidth == atlas.frameWidth && trim.frameHeight == atlas.frameHeight) {
+            return &trim;
+        }
+    }
+    return nullptr;
+}
+
 //animation metadata
 AnimDef idle   = {0, 0, 6, 10};
 AnimDef attack   = {1, 0, 6, 10};
@@ -17,6 +41,8 @@ spriteAnimation CreateSpriteAnimation(Texture2D atlas, int framesPerSecond, Rect
 {
     spriteAnimation spriteAnimation = {
         .atlas = atlas,
+        .Offsets = NULL,
+        .frameSize = {rectanglesCount > 0 ? rectangles[0].width : 0.0f, rectanglesCount > 0 ? rectangles[0].height : 0.0f},
         .framesPerSecond = framesPerSecond,
         .rectanglesCount = rectanglesCount,
         .loop = loop
@@ -37,21 +63,54 @@ spriteAnimation CreateSpriteAnimation(Texture2D atlas, int framesPerSecond, Rect
     return spriteAnimation;
 }
 
-void DrawSpriteAnimationPro(spriteAnimation animation, Rectangle dest, Vector2 origin, float rotation, Color tint, bool facingRight, float elapsedTime)
+static int GetFrameIndex(const spriteAnimation& animation, float elapsedTime)
 {
-    int index;
     if (animation.loop) {
-        index = (int)(elapsedTime * animation.framesPerSecond) % animation.rectanglesCount;
-    } else {
-        // Clamp to last frame if animation shouldn't loop
-        int maxIndex = (int)(elapsedTime * animation.framesPerSecond);
-        index = (maxIndex >= animation.rectanglesCount) ? animation.rectanglesCount - 1 : maxIndex;
+        return (int)(elapsedTime * animation.framesPerSecond) % animation.rectanglesCount;
     }
+    // Clamp to last frame if animation shouldn't loop
+    int maxIndex = (int)(elapsedTime * animation.framesPerSecond);
+    return (maxIndex >= animation.rectanglesCount) ? animation.rectanglesCount - 1 : maxIndex;
+}
+
+// Maps a trimmed frame into the full-cell dest rect, mirrored when the sprite is flipped
+static Rectangle GetTrimmedDest(const spriteAnimation& animation, int index, Rectangle dest, bool facingRight)
+{
     Rectangle sourceRec = animation.Rectangles[index];
+    Vector2 offset = animation.Offsets[index];
+    float scaleX = dest.width / animation.frameSize.x;
+    float scaleY = dest.height / animation.frameSize.y;
+    float offsetX = facingRight ? offset.x : animation.frameSize.x - offset.x - sourceRec.width;
+    return Rectangle{
+        dest.x + offsetX * scaleX,
+        dest.y + offset.y * scaleY,
+        sourceRec.width * scaleX,
+        sourceRec.height * scaleY
+    };
+}
+
+void DrawSpriteAnimationPro(spriteAnimation animation, Rectangle dest, Vector2 origin, float rotation, Color tint, bool facingRight, float elapsedTime)
+{
+    int index = GetFrameIndex(animation, elapsedTime);
+    Rectangle sourceRec = animation.Rectangles[index];
+    if (animation.Offsets != NULL) {
+        // Trimmed frame: only draw the opaque part of the cell
+        if (sourceRec.width <= 0.0f || sourceRec.height <= 0.0f) return;
+        dest = GetTrimmedDest(animation, index, dest, facingRight);
+    }
     if (!facingRight) {
         sourceRec.width = -sourceRec.width;
     }
-    DrawTexturePro(animation.atlas, sourceRec, dest, origin, rotation, tint);
+    GetRenderBackend().DrawTexturePro(animation.atlas, sourceRec, dest, origin, rotation, tint);
+}
+
+Rectangle GetSpriteAnimationBox(spriteAnimation animation, Rectangle dest, bool facingRight, float elapsedTime)
+{
+    if (animation.Offsets == NULL || animation.rectanglesCount <= 0) {
+        return dest;
+    }
+    int index = GetFrameIndex(animation, elapsedTime);
+    return GetTrimmedDest(animation, index, dest, facingRight);
 }
 
 void DisposeSpriteAnimation(spriteAnimation animation)
@@ -59,25 +118,73 @@ void DisposeSpriteAnimation(spriteAnimation animation)
     if (animation.Rectangles != NULL){
         free(animation.Rectangles);
     }
+    if (animation.Offsets != NULL){
+        free(animation.Offsets);
+    }
 }
 
-std::vector<Rectangle> BuildFrames(int startRow,int startCol,int frameCount,int columns,int frameW,int frameH,int trimX,int trimY
-) {
-    std::vector<Rectangle> frames;
-    frames.reserve(frameCount);
+Texture2D LoadTrimmedAtlas(const char* fileName, int frameWidth, int frameHeight)
+{
+    Image image = LoadImagePreloaded(fileName);
+    Texture2D texture;
+    {
+        LoadTimer timer(LOAD_UPLOAD, fileName);
+        texture = GetRenderBackend().LoadTextureFromImage(image);
+        if (image.data != NULL) timer.SetBytes(GetPixelDataSize(image.width, image.height, image.format));
+    }
+    if (image.data == NULL || frameWidth <= 0 || frameHeight <= 0) {
+        UnloadImage(image);
+        return texture;
+    }
 
-    for (int i = 0; i < frameCount; i++) {
-        int col = (startCol + i) % columns;
-        int row = startRow + (startCol + i) / columns;
+    LoadTimer timer(LOAD_PHASE, "asset/atlas-trim");
+    AtlasTrim trim;
+    trim.textureId = texture.id;
+    trim.frameWidth = frameWidth;
+    trim.frameHeight = frameHeight;
+    trim.columns = image.width / frameWidth;
+    int rows = image.height / frameHeight;
+    trim.bounds.reserve(trim.columns * rows);
 
-        frames.push_back(Rectangle{
-            (float)col * frameW + trimX,
-            (float)row * frameH + trimY,
-            (float)frameW - 2 * trimX,
-            (float)frameH - 2* trimY
-        });
+    // Scan each cell once for its opaque bounds; fully transparent cells get an empty rect
+    Color* pixels = LoadImageColors(image);
+    for (int row = 0; row < rows; row++) {
+        for (int col = 0; col < trim.columns; col++) {
+            int minX = frameWidth, minY = frameHeight, maxX = -1, maxY = -1;
+            for (int y = 0; y < frameHeight; y++) {
+                const Color* line = pixels + (row * frameHeight + y) * image.width + col * frameWidth;
+                for (int x = 0; x < frameWidth; x++) {
+                    if (line[x].a == 0) continue;
+                    if (x < minX) minX = x;
+                    if (x > maxX) maxX = x;
+                    if (y < minY) minY = y;
+                    if (y > maxY) maxY = y;
+                }
+            }
+            if (maxX < 0) {
+                trim.bounds.push_back(Rectangle{0, 0, 0, 0});
+            } else {
+                trim.bounds.push_back(Rectangle{(float)minX, (float)minY, (float)(maxX - minX + 1), (float)(maxY - minY + 1)});
+            }
+        }
     }
-    return frames;
+    UnloadImageColors(pixels);
+    UnloadImage(image);
+
+    atlasTrims.push_back(trim);
+    return texture;
+}
+
+void UnloadTrimmedAtlas(Texture2D texture)
+{
+    for (auto it = atlasTrims.begin(); it != atlasTrims.end(); ) {
+        if (it->textureId == texture.id) {
+            it = atlasTrims.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    GetRenderBackend().UnloadTexture(texture);
 }
 
 spriteAnimation LoadAnim(
@@ -102,5 +209,23 @@ spriteAnimation LoadAnim(
         });
     }
 
-    return CreateSpriteAnimation(texture, def.fps, frames.data(), def.frames, loop);
+    spriteAnimation animation = CreateSpriteAnimation(texture, def.fps, frames.data(), def.frames, loop);
+
+    // Swap in the precomputed opaque bounds when the atlas was loaded trimmed
+    const AtlasTrim* trim = FindAtlasTrim(texture, atlas);
+    if (trim == nullptr || animation.Rectangles == NULL) {
+        return animation;
+    }
+    animation.Offsets = (Vector2*)malloc(sizeof(Vector2) * def.frames);
+    if (animation.Offsets == NULL) {
+        return animation;
+    }
+    for (int i = 0; i < def.frames; i++) {
+        Rectangle cell = animation.Rectangles[i];
+        int cellIndex = (int)(cell.y / atlas.frameHeight) * trim->columns + (int)(cell.x / atlas.frameWidth);
+        Rectangle bounds = (cellIndex < (int)trim->bounds.size()) ? trim->bounds[cellIndex] : Rectangle{0, 0, cell.width, cell.height};
+        animation.Rectangles[i] = Rectangle{cell.x + bounds.x, cell.y + bounds.y, bounds.width, bounds.height};
+        animation.Offsets[i] = Vector2{bounds.x, bounds.y};
+    }
+    return animation;
 }
@@ -6,6 +6,8 @@
 typedef struct spriteAnimation {
     Texture2D atlas;
     Rectangle* Rectangles;
+    Vector2* Offsets;   // per-frame offset of the trimmed rect inside its cell (NULL when untrimmed)
+    Vector2 frameSize;  // untrimmed cell size, used to place trimmed frames
     int framesPerSecond;
     int rectanglesCount;
     bool loop;
@@ -30,6 +32,15 @@ void DrawSpriteAnimationPro(spriteAnimation animation, Rectangle dest, Vector2 o
 
 void DisposeSpriteAnimation(spriteAnimation animation);
 
+// Opaque bounds of the frame shown at elapsedTime, mapped into dest (dest itself when untrimmed).
+// Used as the per-frame collision box so hitboxes follow the animation.
+Rectangle GetSpriteAnimationBox(spriteAnimation animation, Rectangle dest, bool facingRight, float elapsedTime);
+
+// Loads an atlas and records the tight alpha bounds of every frameWidth x frameHeight cell.
+// Animations built from it with LoadAnim only draw the opaque part of each frame.
+Texture2D LoadTrimmedAtlas(const char* fileName, int frameWidth, int frameHeight);
+void UnloadTrimmedAtlas(Texture2D texture);
+
 spriteAnimation LoadAnim(
     const AnimDef& def,
     Texture2D texture,
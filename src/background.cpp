@@ -0,0 +1,120 @@
+#include "background.hpp"
+#include "world.hpp"
+#include "render.hpp"
+#include "textures.hpp"
+#include "trace.hpp"
+
+void BackgroundCompositor::AddStack(int stackId, const std::vector<BackgroundLayer>& layers)
+{
+    Stack stack;
+    stack.id = stackId;
+    stack.layers = layers;
+    stack.firstVisible = 0;
+    stack.hasParallax = false;
+    stack.target = {0};
+    stack.valid = false;
+
+    for (int i = 0; i < (int)layers.size(); i++) {
+        if (layers[i].opaque) {
+            stack.firstVisible = i;
+        }
+    }
+    for (int i = stack.firstVisible; i < (int)layers.size(); i++) {
+        if (layers[i].parallax != 0.0f) {
+            stack.hasParallax = true;
+        }
+    }
+    stacks.push_back(stack);
+}
+
+BackgroundCompositor::Stack* BackgroundCompositor::FindStack(int stackId)
+{
+    for (auto& stack : stacks) {
+        if (stack.id == stackId) {
+            return &stack;
+        }
+    }
+    return nullptr;
+}
+
+void BackgroundCompositor::DrawLayer(const BackgroundLayer& layer, Vector2 offset) const
+{
+    Texture2D texture = FindTexture(layer.fileName);
+    if (texture.id == 0) return;
+    GetRenderBackend().DrawTexturePro(
+        texture,
+        {0, 0, (float)texture.width, (float)texture.height},
+        {offset.x, offset.y, (float)GetViewWidth(), (float)GetViewHeight()},
+        {0, 0},
+        0.0f,
+        WHITE
+    );
+}
+
+void BackgroundCompositor::Prepare(int stackId)
+{
+    TRACE_ZONE("BackgroundCompositor::Prepare");
+    Stack* stack = FindStack(stackId);
+    if (stack == nullptr || stack->hasParallax) return;
+
+    RenderBackend& gfx = GetRenderBackend();
+    int width = GetViewWidth();
+    int height = GetViewHeight();
+    if (stack->target.id == 0 || stack->target.texture.width != width || stack->target.texture.height != height) {
+        if (stack->target.id != 0) {
+            gfx.UnloadRenderTexture(stack->target);
+        }
+        stack->target = gfx.LoadRenderTexture(width, height);
+        stack->valid = false;
+    }
+    if (stack->valid) return;
+
+    // A layer evicted with its asset set leaves the stack drawing live until it is resident again
+    bool complete = true;
+    gfx.BeginTextureMode(stack->target);
+    gfx.ClearBackground(BLACK);
+    for (int i = stack->firstVisible; i < (int)stack->layers.size(); i++) {
+        if (FindTexture(stack->layers[i].fileName).id == 0) complete = false;
+        DrawLayer(stack->layers[i], {0, 0});
+    }
+    gfx.EndTextureMode();
+    stack->valid = complete;
+}
+
+void BackgroundCompositor::Draw(int stackId, Vector2 scroll)
+{
+    TRACE_ZONE("BackgroundCompositor::Draw");
+    Stack* stack = FindStack(stackId);
+    if (stack == nullptr) return;
+
+    if (stack->valid && !stack->hasParallax) {
+        // Render textures are stored bottom-up, so flip the source vertically
+        Rectangle source = {0, 0, (float)stack->target.texture.width, -(float)stack->target.texture.height};
+        GetRenderBackend().DrawTextureRec(stack->target.texture, source, {0, 0}, WHITE);
+        return;
+    }
+
+    // Parallax stacks (or a stack not prepared yet) draw only their visible layers live
+    for (int i = stack->firstVisible; i < (int)stack->layers.size(); i++) {
+        const BackgroundLayer& layer = stack->layers[i];
+        DrawLayer(layer, {-scroll.x * layer.parallax, -scroll.y * layer.parallax});
+    }
+}
+
+void BackgroundCompositor::Invalidate()
+{
+    for (auto& stack : stacks) {
+        stack.valid = false;
+    }
+}
+
+void BackgroundCompositor::Unload()
+{
+    for (auto& stack : stacks) {
+        if (stack.target.id != 0) {
+            GetRenderBackend().UnloadRenderTexture(stack.target);
+            stack.target = {0};
+        }
+        stack.valid = false;
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+#include <raylib.h>
+#include <vector>
+
+// One full-screen layer of a background stack
+struct BackgroundLayer {
+    const char* fileName;   // resolved through the texture manager, so it must be resident to draw
+    bool opaque;     // layer covers everything beneath it, so lower layers can be skipped
+    float parallax;  // 0 = fixed to the screen; non-zero layers are drawn live, scrolled by parallax * scroll
+};
+
+// Flattens each background stack into one cached full-screen target so a frame costs a single fill.
+// Layers hidden under an opaque layer are never drawn.
+class BackgroundCompositor {
+public:
+    void AddStack(int stackId, const std::vector<BackgroundLayer>& layers);
+    void Prepare(int stackId);   // composite outside BeginDrawing if the cached target is stale
+    void Draw(int stackId, Vector2 scroll = {0, 0});
+    void Invalidate();
+    void Unload();
+
+private:
+    struct Stack {
+        int id;
+        std::vector<BackgroundLayer> layers;
+        int firstVisible;        // index of the topmost opaque layer (0 if none)
+        bool hasParallax;
+        RenderTexture2D target;
+        bool valid;
+    };
+    std::vector<Stack> stacks;
+
+    Stack* FindStack(int stackId);
+    void DrawLayer(const BackgroundLayer& layer, Vector2 offset) const;
+};
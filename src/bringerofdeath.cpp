@@ -1,5 +1,13 @@
 #include "bringerofdeath.hpp"
 #include "fighter.hpp"
+#include "particles.hpp"
+#include "sfx.hpp"
+#include "textures.hpp"
+#include "loadtimes.hpp"
+#include "tilemap.hpp"
+#include "perfoverlay.hpp"
+#include "render.hpp"
+#include "trace.hpp"
 // #include <algorithm>
 #include <cmath>
 
@@ -11,27 +19,12 @@ static AnimDef DEATH  = {3, 5, 10, 1};
 static AnimDef CAST  = {4, 7, 9, 4};  
 static AnimDef SPELL   = {6, 0, 16, 4};
 
-// Initialize static texture
-Texture2D Boss::sharedAtlas = {0};
-
-void Boss::LoadSharedTexture()
-{
-    if (sharedAtlas.id == 0) {
-        sharedAtlas = LoadTexture("resources/enemies/Bringer-Of-Death/SpriteSheet/Bringer-of-Death-SpritSheet.png");
-    }
-}
-
-void Boss::UnloadSharedTexture()
-{
-    if (sharedAtlas.id != 0) {
-        UnloadTexture(sharedAtlas);
-        sharedAtlas = {0};
-    }
-}
+const TextureAsset Boss::SHEET = {"resources/enemies/Bringer-Of-Death/SpriteSheet/Bringer-of-Death-SpritSheet.png", 140, 93};
 
 Boss::Boss()
 {
-    LoadSharedTexture();
+    LoadTimer timer(LOAD_PHASE, "construct/Boss");
+    atlas = AcquireAsset(SHEET);
 
     textureWidth  = 140;
     textureHeight = 93;
@@ -40,15 +33,15 @@ Boss::Boss()
 
     atlasInfo.frameWidth  = textureWidth;
     atlasInfo.frameHeight = textureHeight;
-    atlasInfo.columns     = sharedAtlas.width / textureWidth;
+    atlasInfo.columns     = atlas.width / textureWidth;
 
-    attack1Anim  = LoadAnim(ATTACK1,  sharedAtlas, atlasInfo, false);
-    castAnim  = LoadAnim(CAST,  sharedAtlas, atlasInfo, false);
-    spellAnim  = LoadAnim(SPELL,  sharedAtlas, atlasInfo, false);
-    hurtAnim = LoadAnim(HURT, sharedAtlas, atlasInfo, false);
-    dieAnim  = LoadAnim(DEATH,  sharedAtlas, atlasInfo, false);
-    idleAnim = LoadAnim(IDLE, sharedAtlas, atlasInfo, true);
-    walkAnim = LoadAnim(WALK, sharedAtlas, atlasInfo, true);
+    attack1Anim  = LoadAnim(ATTACK1,  atlas, atlasInfo, false);
+    castAnim  = LoadAnim(CAST,  atlas, atlasInfo, false);
+    spellAnim  = LoadAnim(SPELL,  atlas, atlasInfo, false);
+    hurtAnim = LoadAnim(HURT, atlas, atlasInfo, false);
+    dieAnim  = LoadAnim(DEATH,  atlas, atlasInfo, false);
+    idleAnim = LoadAnim(IDLE, atlas, atlasInfo, true);
+    walkAnim = LoadAnim(WALK, atlas, atlasInfo, true);
 
     position = { 1200.0f, 400.0f };
     scale = 5.0f;
@@ -67,7 +60,7 @@ Boss::Boss()
 
     state = State::Idle;
     lastState = State::Idle;
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
     spellStartPos = {0.0f, 0.0f};
     spellStarted = false;
 }
@@ -86,16 +79,16 @@ Boss::~Boss()
     DisposeSpriteAnimation(dieAnim);
     DisposeSpriteAnimation(idleAnim);
     DisposeSpriteAnimation(walkAnim);
-    // Do not unload shared texture - managed by LoadSharedTexture/UnloadSharedTexture
+    ReleaseTexture(atlas);
 }
 
 Rectangle Boss::GetRect() const
 {
     return Rectangle{ position.x, position.y, (float)width, (float)height };
 }
-Rectangle Boss::GetHitbox() const
+Rectangle Boss::GetBodyBox() const
 {
-   // Use full standing height for collision to avoid flicker/jitter when crouching
+   // Fixed physics box used for platform collision, AI and attack placement
     float offsetXleft = 84.0f * scale;
     float offsetXright = 13.0f * scale;
     float offsetY = 37.0f * scale;
@@ -107,12 +100,32 @@ Rectangle Boss::GetHitbox() const
     return Rectangle{x, y, w, h};
 }
 
+Rectangle Boss::GetHitbox() const
+{
+    // Combat box follows the opaque bounds of the current animation frame. Attack1 frames include
+    // the scythe, which GetAttack1Hitbox covers, so the swing keeps the idle body box.
+    if (state == State::Attack1) {
+        return GetSpriteAnimationBox(idleAnim, GetDrawRect(), facingRight, 0.0f);
+    }
+    float elapsed = GetGameTime() - animationStartTime;
+    return GetSpriteAnimationBox(CurrentAnimation(), GetDrawRect(), facingRight, elapsed);
+}
+
 bool Boss::CheckPlatformCollision(const std::vector<Platform>& platforms)
 {
-    Rectangle rect = GetHitbox();
+    Rectangle rect = GetBodyBox();
     bool grounded = false;
 
+    const TileMap* tiles = GetActiveTileMap();
+    TileSurface surface;
+    if (tiles != nullptr && speedY >= 0 && tiles->FindSurface(rect, false, surface)) {
+        position.y = surface.rect.y - height;
+        speedY = 0.0f;
+        return true;
+    }
+
     for (const auto& platform : platforms) {
+        CountPerf(PERF_COLLISION_TESTS);
         Rectangle pr = platform.GetRect();
         if (speedY >= 0 && rect.x + rect.width > pr.x && rect.x < pr.x + pr.width) {
             float bottom = rect.y + rect.height;
@@ -132,23 +145,28 @@ void Boss::TakeDamage(float damageAmount)
 {
     if (isDying || isDeadFinal) return;
     SetState(State::Hurt);
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
     health -= damageAmount;
+    EmitHitBurst(GetBodyBox(), Color{150, 60, 200, 255});
+    PlaySfx(SFX_HIT);
     if (health <= 0.0f) {
         health = 0.0f;
         isDying = true;
+        EmitDeathBurst(GetBodyBox(), Color{150, 60, 200, 255});
+        PlaySfx(SFX_ENEMY_DEATH);
     }
 }
 
 void Boss::Update(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player)
 {
+    TRACE_ZONE("Boss::Update");
     playerRectCache = player.GetHitbox();
 
     if (isDeadFinal) return;
 
     if (isDying) {
         state = State::Die;
-        float elapsed = GetTime() - animationStartTime;
+        float elapsed = GetGameTime() - animationStartTime;
         if (elapsed >= 10.0f) { // death animation lasts 10 seconds
             isDeadFinal = true;
         }
@@ -157,11 +175,11 @@ void Boss::Update(const std::vector<Platform>& platforms, const std::vector<Wall
 
     // Face player
     float playerCenterX = player.GetHitbox().x + player.GetHitbox().width * 0.5f;
-    float myCenterX = position.x + GetHitbox().width/2;
+    float myCenterX = position.x + GetBodyBox().width/2;
     facingRight = (playerCenterX <= myCenterX);
 
     if(state == State::Hurt) {
-        float elapsed = GetTime() - animationStartTime;
+        float elapsed = GetGameTime() - animationStartTime;
         if (elapsed >= 0.3f) { // hurt animation duration
             SetState(State::Idle);
         }
@@ -180,14 +198,27 @@ void Boss::Update(const std::vector<Platform>& platforms, const std::vector<Wall
                     spellStartPos = {player.GetHitbox().x, player.GetHitbox().y};
                     spellStarted = true;
                     castTimer = 0.0f;  // Reset timer when cast begins
+                    emberTime = 0.0f;
+                    EmitParticles(ParticleBurst{spellStartPos, 160, Color{120, 40, 220, 255}, 300.0f, PI, 0.0f, 0.8f, 6.0f, -200.0f});
+                    PlaySfx(SFX_BOSS_CAST);
+                }
+                // Embers rising from the spell while it grows, at a fixed rate whatever the frame rate
+                {
+                    const float EMBERS_PER_SECOND = 360.0f;
+                    emberTime += GetGameFrameTime();
+                    int embers = (int)(emberTime * EMBERS_PER_SECOND);
+                    if (embers > 0) {
+                        emberTime -= embers / EMBERS_PER_SECOND;
+                        EmitParticles(ParticleBurst{{spellStartPos.x, spellStartPos.y + 40.0f}, embers, Color{190, 90, 255, 200}, 180.0f, PI * 0.25f, -PI * 0.5f, 0.9f, 5.0f, -120.0f});
+                    }
                 }
                 // Update cast timer for hitbox growth
-                castTimer += GetFrameTime();
+                castTimer += GetGameFrameTime();
                 break;
             default:
                 break;
         }
-        float elapsed = GetTime() - animationStartTime;
+        float elapsed = GetGameTime() - animationStartTime;
         if (elapsed >= animDuration) {
             SetState(State::Idle);
             spellStarted = false; // Reset for next cast
@@ -196,7 +227,7 @@ void Boss::Update(const std::vector<Platform>& platforms, const std::vector<Wall
     }
     //after 15 seconds the boss will perform a cast attack
     static float castTimer = 0.0f;
-    castTimer += GetFrameTime();
+    castTimer += GetGameFrameTime();
     if (castTimer >= castCooldown) {
         SetState(State::Cast);
         castTimer = 0.0f;
@@ -223,19 +254,12 @@ void Boss::Update(const std::vector<Platform>& platforms, const std::vector<Wall
 
 void Boss::Draw()
 {
+    TRACE_ZONE("Boss::Draw");
     if (isDeadFinal) return;
-    float elapsed = GetTime() - animationStartTime;
+    float elapsed = GetGameTime() - animationStartTime;
     Vector2 origin{0,0};
     
-    // Use full sprite rectangle for drawing to prevent visual jumping
-    Rectangle dest = GetRect();
-    
-    // Apply horizontal offset to compensate for asymmetric sprite when flipping
-    // Adjust this value based on how off-center the sprite is in the texture
-    float flipOffset = 380.0f; // Compensates for character position in texture
-    if (facingRight) {
-        dest.x -= flipOffset;
-    }
+    Rectangle dest = GetDrawRect();
     
     // Draw spell at stored position (not following player)
     Rectangle spellDest;
@@ -257,35 +281,44 @@ void Boss::Draw()
     // float myCenterX =position.x + GetHitbox().width/2; // adjust for sprite center
     // DrawCircle(myCenterX, 250, 50.0f, RED); // Debug: draw center point
 
-    switch (state) {
-        case State::Attack1:
-            DrawSpriteAnimationPro(attack1Anim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Cast:
-            DrawSpriteAnimationPro(castAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            DrawSpriteAnimationPro(spellAnim, spellDest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Hurt:
-            DrawSpriteAnimationPro(hurtAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Die:
-            DrawSpriteAnimationPro(dieAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Idle:
-            DrawSpriteAnimationPro(idleAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Walk:
-            DrawSpriteAnimationPro(walkAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
+    DrawSpriteAnimationPro(CurrentAnimation(), dest, origin, 0.0f, WHITE, facingRight, elapsed);
+    if (state == State::Cast) {
+        DrawSpriteAnimationPro(spellAnim, spellDest, origin, 0.0f, WHITE, facingRight, elapsed);
+    }
+
+}
+
+Rectangle Boss::GetDrawRect() const
+{
+    // Use full sprite rectangle for drawing to prevent visual jumping
+    Rectangle dest = GetRect();
+
+    // Apply horizontal offset to compensate for asymmetric sprite when flipping
+    // Adjust this value based on how off-center the sprite is in the texture
+    float flipOffset = 380.0f; // Compensates for character position in texture
+    if (facingRight) {
+        dest.x -= flipOffset;
     }
+    return dest;
+}
 
+const spriteAnimation& Boss::CurrentAnimation() const
+{
+    switch (state) {
+        case State::Attack1: return attack1Anim;
+        case State::Cast:    return castAnim;
+        case State::Hurt:    return hurtAnim;
+        case State::Die:     return dieAnim;
+        case State::Walk:    return walkAnim;
+        default:             return idleAnim;
+    }
 }
 
 void Boss::SetState(State newState)
 {
     if (state != newState) {
         state = newState;
-        animationStartTime = GetTime();
+        animationStartTime = GetGameTime();
         lastState = newState;
     }
 }
@@ -298,12 +331,12 @@ Rectangle Boss::GetAttack1Hitbox() const
     }
 
     // Add 1 second buffer before hitbox spawns (use elapsed time from animation start)
-    float elapsed = GetTime() - animationStartTime;
+    float elapsed = GetGameTime() - animationStartTime;
     if (elapsed < 0.5f) {
         return Rectangle{0, 0, 0, 0};
     }
 
-    Rectangle attack1Hitbox = GetHitbox();
+    Rectangle attack1Hitbox = GetBodyBox();
 
     // Facing logic: when facingRight is true, boss looks left (toward smaller X)
     // Place the hitbox forward in the facing direction with a modest vertical offset
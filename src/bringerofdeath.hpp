@@ -4,6 +4,7 @@
 #include "platform.hpp"
 #include "animation.h"
 #include "enemy.hpp"
+#include "textures.hpp"
 
 class Fighter; // forward declaration
 
@@ -20,13 +21,16 @@ public:
     void TakeDamage(float damageAmount) override;
     bool IsDead() const override { return isDeadFinal; }
     float GetHealth() const override { return health; }
-    void LoadSharedTexture();
-    void UnloadSharedTexture();
+    void RestoreHealth(float value) override { health = value; }
+    float GetMaxHealth() const { return maxHealth; }
+    static const TextureAsset SHEET;    // kept resident by the level asset sets
     Rectangle GetAttack1Hitbox() const;
     Rectangle GetCastHitbox() const;
 
 private:
-    static Texture2D sharedAtlas;
+    friend struct BenchAccess;  // tools/bench.cpp times the collision helpers directly
+
+    Texture2D atlas;
     AtlasInfo atlasInfo;
     spriteAnimation attack1Anim;
     spriteAnimation castAnim;
@@ -64,6 +68,7 @@ private:
     bool isDeadFinal;
     float castCooldown;
     float castTimer;
+    float emberTime;        // cast time not yet spent on embers
 
     enum class State { Idle, Walk, Hurt, Die, Attack1, Cast};
     State state;
@@ -71,5 +76,8 @@ private:
     float animationStartTime;
 
     void SetState(State newState);
+    const spriteAnimation& CurrentAnimation() const;
+    Rectangle GetBodyBox() const;
+    Rectangle GetDrawRect() const;
     bool CheckPlatformCollision(const std::vector<Platform>& platforms);
 };
@@ -0,0 +1,70 @@
+#include "camera.hpp"
+#include "world.hpp"
+
+GameCamera::GameCamera()
+{
+    camera.offset = {0, 0};
+    camera.target = {0, 0};
+    camera.rotation = 0.0f;
+    camera.zoom = 1.0f;
+    followSpeed = 6.0f;
+}
+
+Vector2 GameCamera::ClampTarget(Vector2 target) const
+{
+    // Keep the view inside the world; a world smaller than the screen is centred
+    Rectangle world = GetWorldBounds();
+    float halfW = GetViewWidth() * 0.5f / camera.zoom;
+    float halfH = GetViewHeight() * 0.5f / camera.zoom;
+
+    if (world.width <= halfW * 2.0f) {
+        target.x = world.x + world.width * 0.5f;
+    } else if (target.x < world.x + halfW) {
+        target.x = world.x + halfW;
+    } else if (target.x > world.x + world.width - halfW) {
+        target.x = world.x + world.width - halfW;
+    }
+
+    if (world.height <= halfH * 2.0f) {
+        target.y = world.y + world.height * 0.5f;
+    } else if (target.y < world.y + halfH) {
+        target.y = world.y + halfH;
+    } else if (target.y > world.y + world.height - halfH) {
+        target.y = world.y + world.height - halfH;
+    }
+    return target;
+}
+
+void GameCamera::Reset(Rectangle target)
+{
+    camera.offset = {GetViewWidth() * 0.5f, GetViewHeight() * 0.5f};
+    camera.target = ClampTarget({target.x + target.width * 0.5f, target.y + target.height * 0.5f});
+    SetWorldView(GetView());
+}
+
+void GameCamera::Follow(Rectangle target, float deltaTime)
+{
+    camera.offset = {GetViewWidth() * 0.5f, GetViewHeight() * 0.5f};
+    Vector2 goal = ClampTarget({target.x + target.width * 0.5f, target.y + target.height * 0.5f});
+
+    float t = followSpeed * deltaTime;
+    if (t > 1.0f) t = 1.0f;
+    camera.target.x += (goal.x - camera.target.x) * t;
+    camera.target.y += (goal.y - camera.target.y) * t;
+    SetWorldView(GetView());
+}
+
+Camera2D GameCamera::GetScaled(float renderScale) const
+{
+    Camera2D scaled = camera;
+    scaled.offset = {camera.offset.x * renderScale, camera.offset.y * renderScale};
+    scaled.zoom = camera.zoom * renderScale;
+    return scaled;
+}
+
+Rectangle GameCamera::GetView() const
+{
+    float width = GetViewWidth() / camera.zoom;
+    float height = GetViewHeight() / camera.zoom;
+    return Rectangle{camera.target.x - width * 0.5f, camera.target.y - height * 0.5f, width, height};
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include <raylib.h>
+
+// World-space camera that follows a target and stays inside the world bounds
+class GameCamera {
+public:
+    GameCamera();
+    void Reset(Rectangle target);
+    void Follow(Rectangle target, float deltaTime);
+    Camera2D Get() const { return camera; }
+    Camera2D GetScaled(float renderScale) const;  // same view mapped onto a render target renderScale times the view size
+    Rectangle GetView() const;
+
+private:
+    Camera2D camera;
+    float followSpeed;  // how quickly the camera catches up, per second
+
+    Vector2 ClampTarget(Vector2 target) const;
+};
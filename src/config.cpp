@@ -0,0 +1,176 @@
+#include "config.hpp"
+#include <raylib.h>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+static const char* CONFIG_FILE = "game.cfg";
+
+static bool ParsePacingMode(const std::string& value, PacingMode& mode)
+{
+    if (value == "uncapped") mode = PacingMode::Uncapped;
+    else if (value == "vsync") mode = PacingMode::VSync;
+    else if (value == "fixed") mode = PacingMode::Fixed;
+    else if (value == "adaptive") mode = PacingMode::Adaptive;
+    else return false;
+    return true;
+}
+
+static void ApplyOption(GameConfig& config, const std::string& key, const std::string& value)
+{
+    if (key == "pacing") {
+        if (!ParsePacingMode(value, config.pacing)) {
+            TraceLog(LOG_WARNING, "CONFIG: Unknown pacing mode '%s'", value.c_str());
+        }
+    } else if (key == "fps") {
+        int fps = atoi(value.c_str());
+        if (fps > 0) config.targetFps = fps;
+    } else if (key == "render-width") {
+        int width = atoi(value.c_str());
+        if (width > 0) config.renderWidth = width;
+    } else if (key == "render-height") {
+        int height = atoi(value.c_str());
+        if (height > 0) config.renderHeight = height;
+    } else if (key == "particle-budget") {
+        int budget = atoi(value.c_str());
+        if (budget > 0) config.particleBudget = budget;
+    } else if (key == "headless") {
+        int frames = atoi(value.c_str());
+        if (frames >= 0) config.headlessFrames = frames;
+    } else if (key == "asset-pack") {
+        config.assetPack = value;
+    } else if (key == "load-report") {
+        config.loadReport = value;
+    } else if (key == "startup-budget-ms") {
+        float budget = (float)atof(value.c_str());
+        if (budget >= 0.0f) config.startupBudgetMs = budget;
+    } else if (key == "level-budget-ms") {
+        float budget = (float)atof(value.c_str());
+        if (budget >= 0.0f) config.levelBudgetMs = budget;
+    } else if (key == "fail-over-budget") {
+        config.failOverBudget = (value == "1" || value == "true");
+    } else if (key == "convert-level") {
+        config.convertLevel = value;
+    } else if (key == "generate") {
+        config.generateLevel = (value == "1" || value == "true");
+    } else if (key == "gen-seed") {
+        config.genSeed = (unsigned int)strtoul(value.c_str(), NULL, 10);
+    } else if (key == "gen-width") {
+        float width = (float)atof(value.c_str());
+        if (width >= 1920.0f && width <= 1000000.0f) config.genWidth = width;
+    } else if (key == "gen-height") {
+        float height = (float)atof(value.c_str());
+        if (height >= 1080.0f && height <= 100000.0f) config.genHeight = height;
+    } else if (key == "gen-platform-density") {
+        float density = (float)atof(value.c_str());
+        if (density >= 0.0f && density <= 1.0f) config.genPlatformDensity = density;
+    } else if (key == "gen-enemy-density") {
+        float density = (float)atof(value.c_str());
+        if (density >= 0.0f) config.genEnemyDensity = density;
+    } else if (key == "gen-tiles") {
+        config.genTiles = (value == "1" || value == "true");
+    } else if (key == "stream-levels") {
+        config.streamLevels = (value == "1" || value == "true");
+    } else if (key == "stream-chunk-width") {
+        float width = (float)atof(value.c_str());
+        if (width >= 512.0f) config.streamChunkWidth = width;
+    } else if (key == "stream-cache") {
+        if (!value.empty()) config.streamCache = value;
+    } else if (key == "perf-overlay") {
+        config.perfOverlay = (value == "1" || value == "true");
+    } else if (key == "trace-file") {
+        if (!value.empty()) config.traceFile = value;
+    } else {
+        TraceLog(LOG_WARNING, "CONFIG: Unknown option '%s'", key.c_str());
+    }
+}
+
+static void ApplyLine(GameConfig& config, std::string line)
+{
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) line.erase(comment);
+    size_t equals = line.find('=');
+    if (equals == std::string::npos) return;
+
+    auto trim = [](std::string text) {
+        const char* blanks = " \t\r\n";
+        size_t first = text.find_first_not_of(blanks);
+        if (first == std::string::npos) return std::string();
+        size_t last = text.find_last_not_of(blanks);
+        return text.substr(first, last - first + 1);
+    };
+    std::string key = trim(line.substr(0, equals));
+    std::string value = trim(line.substr(equals + 1));
+    if (!key.empty()) ApplyOption(config, key, value);
+}
+
+GameConfig LoadGameConfig(int argc, char** argv)
+{
+    GameConfig config;
+    config.pacing = PacingMode::Fixed;
+    config.targetFps = 60;
+    config.renderWidth = 1920;
+    config.renderHeight = 1080;
+    config.particleBudget = 60000;
+    config.headlessFrames = 0;
+    config.assetPack = "resources.pak";
+    config.loadReport = "load_report.json";
+    config.startupBudgetMs = 0.0f;
+    config.levelBudgetMs = 0.0f;
+    config.failOverBudget = false;
+    config.convertLevel.clear();
+    config.generateLevel = false;
+    config.genSeed = 1;
+    config.genWidth = 7680.0f;
+    config.genHeight = 2160.0f;
+    config.genPlatformDensity = 0.6f;
+    config.genEnemyDensity = 2.0f;
+    config.genTiles = false;
+    config.streamLevels = true;
+    config.streamChunkWidth = 2048.0f;
+    config.streamCache = "stream.cache";
+    config.perfOverlay = false;
+    config.traceFile = "trace.json";
+
+    if (FileExists(CONFIG_FILE)) {
+        char* text = LoadFileText(CONFIG_FILE);
+        if (text != NULL) {
+            std::string contents = text;
+            UnloadFileText(text);
+            size_t start = 0;
+            while (start <= contents.size()) {
+                size_t end = contents.find('\n', start);
+                if (end == std::string::npos) end = contents.size();
+                ApplyLine(config, contents.substr(start, end - start));
+                start = end + 1;
+            }
+        }
+    }
+
+    // Command line wins over the config file
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--", 2) == 0) {
+            ApplyLine(config, argv[i] + 2);
+        }
+    }
+
+    // The frame is the 16:9 layout scaled by one factor; any other shape would crop or letterbox
+    // it inside the target and then get stretched to the window
+    int height = (config.renderWidth * 9 + 8) / 16;
+    if (config.renderHeight != height) {
+        TraceLog(LOG_WARNING, "CONFIG: Render size %dx%d is not 16:9, using %dx%d", config.renderWidth, config.renderHeight, config.renderWidth, height);
+        config.renderHeight = height;
+    }
+    return config;
+}
+
+const char* PacingModeName(PacingMode mode)
+{
+    switch (mode) {
+        case PacingMode::Uncapped: return "uncapped";
+        case PacingMode::VSync:    return "vsync";
+        case PacingMode::Fixed:    return "fixed";
+        case PacingMode::Adaptive: return "adaptive";
+    }
+    return "unknown";
+}
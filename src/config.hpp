@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+
+enum class PacingMode {
+    Uncapped,   // no limiter, for benchmarking true frame cost
+    VSync,      // block on the display's vertical sync
+    Fixed,      // hybrid sleep + spin limiter at targetFps
+    Adaptive    // like Fixed at the monitor refresh rate, halving the target while frames run over budget
+};
+
+// Start-up options. Read from game.cfg (key=value lines) and then overridden by
+// command line arguments of the form --key=value.
+struct GameConfig {
+    PacingMode pacing;
+    int targetFps;
+    int renderWidth;    // internal render resolution, upscaled to the window
+    int renderHeight;   // kept at 16:9 to match renderWidth, like the 1920x1080 layout
+    int particleBudget; // live particle cap, bursts thin out as it fills
+    int headlessFrames; // >0 runs that many frames on the null render backend without a window
+    std::string assetPack;  // archive built by tools/assetpack; loose files are used when it is missing
+    std::string loadReport; // load timing report written on exit; empty disables it
+    float startupBudgetMs;  // 0 = no budget; start to first interactive frame
+    float levelBudgetMs;    // 0 = no budget; any single level transition
+    bool failOverBudget;    // exit with status 1 when a budget was exceeded
+    std::string convertLevel;   // text level to write out as .lvb next to it, then exit
+    bool generateLevel;         // headless runs play a generated level instead of Level 1
+    unsigned int genSeed;       // generated level settings, see LevelGenSettings
+    float genWidth;
+    float genHeight;
+    float genPlatformDensity;
+    float genEnemyDensity;
+    bool genTiles;
+    bool streamLevels;          // stream levels at least four chunks wide instead of keeping them resident
+    float streamChunkWidth;
+    std::string streamCache;    // scratch file holding the chunks that are not in memory
+    bool perfOverlay;           // show the performance overlay from the start (F3 toggles it)
+    std::string traceFile;      // timeline written on F4 and on exit in -DGAME_TRACE builds
+};
+
+GameConfig LoadGameConfig(int argc, char** argv);
+const char* PacingModeName(PacingMode mode);
@@ -19,6 +19,7 @@ public:
     virtual void TakeDamage(float damageAmount) = 0;
     virtual bool IsDead() const = 0;
     virtual float GetHealth() const = 0;
+    virtual void RestoreHealth(float health) = 0;  // for enemies saved and respawned by level streaming
     static bool allEnemiesDefeated(const std::vector<Enemy*>& enemies) {
         for (const auto* enemy : enemies) {
             if (!enemy->IsDead()) {
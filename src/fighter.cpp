@@ -3,13 +3,23 @@
 #include "enemy.hpp"
 #include "huntress.hpp"
 #include "bringerofdeath.hpp"
+#include "world.hpp"
+#include "particles.hpp"
+#include "sfx.hpp"
+#include "render.hpp"
+#include "textures.hpp"
+#include "loadtimes.hpp"
+#include "tilemap.hpp"
+#include "perfoverlay.hpp"
+#include "trace.hpp"
 #include <raylib.h>
 
 Fighter::Fighter()
 {
+    LoadTimer timer(LOAD_PHASE, "construct/Fighter");
 
-    fighterSet1 = LoadTexture("resources/char_red_1.png");
-    fighterSet2 = LoadTexture("resources/char_red_2.png");
+    fighterSet1 = AcquireAtlas("resources/char_red_1.png", 56, 56);
+    fighterSet2 = AcquireTexture("resources/char_red_2.png");
     frameCount = 6;
     textureWidth = 56;
     textureHeight = 56;
@@ -35,7 +45,7 @@ Fighter::Fighter()
     scale = 3.5;
     width = (textureWidth * scale);
     height = (textureHeight * scale);
-    speed = 5;
+    speed = RUN_SPEED;
     speedY = 0.0f;
     animationStartTime = 0.0f;
     isOnGround = true;
@@ -73,6 +83,14 @@ Fighter::~Fighter()
     DisposeSpriteAnimation(comboAnimation);
 }
 
+void Fighter::UnloadTextures()
+{
+    ReleaseTexture(fighterSet1);
+    ReleaseTexture(fighterSet2);
+    fighterSet1 = {0};
+    fighterSet2 = {0};
+}
+
 void Fighter::Reset()
 {
     // Reset position and movement
@@ -122,7 +140,7 @@ void Fighter::PerformSlash(Enemy& enemy)
     if (hasDealtDamage || !isAttacking) return; // Already dealt damage this attack or not attacking
     
     // Check if hitbox delay has elapsed
-    float elapsedTime = GetTime() - animationStartTime;
+    float elapsedTime = GetGameTime() - animationStartTime;
     if (elapsedTime < attackHitboxDelay) return; // Hitbox not active yet
     
     Rectangle attackBox = GetAttackHitbox();
@@ -141,7 +159,7 @@ void Fighter::PerformComboSlash(Enemy& enemy)
     if (hasDealtDamage || !comboAttack) return; // Already dealt damage this attack or not combo attacking
     
     // Check if hitbox delay has elapsed
-    float elapsedTime = GetTime() - animationStartTime;
+    float elapsedTime = GetGameTime() - animationStartTime;
     if (elapsedTime < attackHitboxDelay) return; // Hitbox not active yet
     
     Rectangle attackBox = GetAttackHitbox();
@@ -156,49 +174,23 @@ void Fighter::PerformComboSlash(Enemy& enemy)
 
 void Fighter::Draw()
 {
+    TRACE_ZONE("Fighter::Draw");
     // DrawRectangleLinesEx(GetHitbox(), 1.0f, RED); // Debug: draw hitbox
-    float elapsedTime = GetTime() - animationStartTime;
+    float elapsedTime = GetGameTime() - animationStartTime;
+    Vector2 origin = {0, 0};
+    DrawSpriteAnimationPro(CurrentAnimation(), GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
+}
 
-    if (isDying)
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(deathAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
-    else if (comboAttack)
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(comboAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
-    else if (isAttacking)
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(attackAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
-    else if (isJumping)
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(jumpAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
-    else if (isLanding)
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(landAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
-    else if (isCrouching)
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(crouchAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
-    else if (isRunning)
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(runAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
-    else
-    {
-        Vector2 origin = {0, 0};
-        DrawSpriteAnimationPro(idleAnimation, GetRect(), origin, 0, WHITE, facingRight, elapsedTime);
-    }
+const spriteAnimation& Fighter::CurrentAnimation() const
+{
+    if (isDying) return deathAnimation;
+    if (comboAttack) return comboAnimation;
+    if (isAttacking) return attackAnimation;
+    if (isJumping) return jumpAnimation;
+    if (isLanding) return landAnimation;
+    if (isCrouching) return crouchAnimation;
+    if (isRunning) return runAnimation;
+    return idleAnimation;
 }
 
 Rectangle Fighter::GetRect() const
@@ -235,13 +227,36 @@ Rectangle Fighter::GetHitbox() const
     return Rectangle{x, y, w, h};
 }
 
+Rectangle Fighter::GetHurtbox() const
+{
+    // Damage box follows the opaque bounds of the current animation frame. Attack and combo
+    // frames include the blade, so those use the idle pose: the sword never takes contact damage.
+    if (!isDying && (comboAttack || isAttacking)) {
+        return GetSpriteAnimationBox(idleAnimation, GetRect(), facingRight, 0.0f);
+    }
+    float elapsedTime = GetGameTime() - animationStartTime;
+    return GetSpriteAnimationBox(CurrentAnimation(), GetRect(), facingRight, elapsedTime);
+}
+
 bool Fighter::CheckPlatformCollision(const std::vector<Platform> &platforms)
 {
     Rectangle fighterRect = GetHitbox();
     standingOnGroundPlatform = false;
 
+    // Tile levels answer from the cells under the feet
+    const TileMap *tiles = GetActiveTileMap();
+    TileSurface surface;
+    if (tiles != nullptr && speedY >= 0 && tiles->FindSurface(fighterRect, isFallingThrough, surface))
+    {
+        position.y = surface.rect.y - height;
+        speedY = 0.0f;
+        standingOnGroundPlatform = surface.ground;
+        return true;
+    }
+
     for (const auto &platform : platforms)
     {
+        CountPerf(PERF_COLLISION_TESTS);
         Rectangle platformRect = platform.GetRect();
 
         // Skip collision if we're falling through platforms (but not ground)
@@ -284,6 +299,7 @@ bool Fighter::CheckWallCollision(const std::vector<Wall> &walls)
 
     for (const auto &wall : walls)
     {
+        CountPerf(PERF_COLLISION_TESTS);
         Rectangle wallRect = wall.GetRect();
         
         // Check if fighter can stand on top of the wall
@@ -340,12 +356,25 @@ bool Fighter::CheckWallCollision(const std::vector<Wall> &walls)
         }
     }
 
+    // Solid tiles block sideways like walls, with the same 10px allowance at the top and bottom
+    const TileMap *tiles = GetActiveTileMap();
+    Rectangle blocked;
+    Rectangle sides = {fighterRect.x, fighterRect.y + 10.0f, fighterRect.width, fighterRect.height - 20.0f};
+    if (tiles != nullptr && tiles->FindSolidOverlap(sides, blocked))
+    {
+        if (fighterRect.x + fighterRect.width * 0.5f < blocked.x + blocked.width * 0.5f)
+            position.x -= fighterRect.x + fighterRect.width - blocked.x;
+        else
+            position.x += blocked.x + blocked.width - fighterRect.x;
+        return true;
+    }
+
     return standingOnWallTop;
 }
 
 void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
 {
-    float deltaTime = GetFrameTime();
+    float deltaTime = GetGameFrameTime();
     
     // Handle ongoing death animation
     if (isDying) {
@@ -375,7 +404,7 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
                 continue;
             }
 
-            Rectangle a = GetHitbox();
+            Rectangle a = GetHurtbox();
             Rectangle b = enemy->GetHitbox();
             
             if (CheckCollisionRecs(a, b)) {
@@ -384,8 +413,10 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
                 width = textureWidth * scale;
                 height = textureHeight * scale;
                 deathTimer = 0.0f;
-                animationStartTime = GetTime(); // start death animation from frame 0
+                animationStartTime = GetGameTime(); // start death animation from frame 0
                 lives -= 1;
+                EmitDeathBurst(GetHurtbox(), Color{220, 30, 30, 255});
+                PlaySfx(SFX_PLAYER_DEATH);
                 break; // Only take damage once per frame
             }
         }
@@ -405,7 +436,7 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
                         continue;
                     }
 
-                    Rectangle a = GetHitbox();
+                    Rectangle a = GetHurtbox();
                     Rectangle b = spear.GetRect();
                     
                     if (CheckCollisionRecs(a, b)) {
@@ -414,8 +445,10 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
                         width = textureWidth * scale;
                         height = textureHeight * scale;
                         deathTimer = 0.0f;
-                        animationStartTime = GetTime(); // start death animation from frame 0
+                        animationStartTime = GetGameTime(); // start death animation from frame 0
                         lives -= 1;
+                        EmitDeathBurst(GetHurtbox(), Color{220, 30, 30, 255});
+                        PlaySfx(SFX_PLAYER_DEATH);
                         return; // Exit immediately after taking damage
                     }
                 }
@@ -431,7 +464,7 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
             // Try to cast to Boss to get attack hitboxes
             const Boss* boss = dynamic_cast<const Boss*>(enemy);
             if (boss) {
-                Rectangle a = GetHitbox();
+                Rectangle a = GetHurtbox();
                 
                 // Check Attack1 hitbox
                 Rectangle attack1Box = boss->GetAttack1Hitbox();
@@ -440,8 +473,10 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
                     width = textureWidth * scale;
                     height = textureHeight * scale;
                     deathTimer = 0.0f;
-                    animationStartTime = GetTime();
+                    animationStartTime = GetGameTime();
                     lives -= 1;
+                    EmitDeathBurst(GetHurtbox(), Color{220, 30, 30, 255});
+                    PlaySfx(SFX_PLAYER_DEATH);
                     return;
                 }
                 
@@ -452,8 +487,10 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
                     width = textureWidth * scale;
                     height = textureHeight * scale;
                     deathTimer = 0.0f;
-                    animationStartTime = GetTime();
+                    animationStartTime = GetGameTime();
                     lives -= 1;
+                    EmitDeathBurst(GetHurtbox(), Color{220, 30, 30, 255});
+                    PlaySfx(SFX_PLAYER_DEATH);
                     return;
                 }
             }
@@ -464,11 +501,10 @@ void Fighter::characterDeath(const std::vector<Enemy*>& enemies)
 
 void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<Wall> &walls)
 {
-    const int screenWidth = GetScreenWidth();
-    const int screenHeight = GetScreenHeight();
-    const float GRAVITY = 800.0f;
-    const int JUMP_VELOCITY = -500;
-    float deltaTime = GetFrameTime();
+    TRACE_ZONE("Fighter::Update");
+    const float worldWidth = GetWorldWidth();
+    const float worldHeight = GetWorldHeight();
+    float deltaTime = GetGameFrameTime();
 
     // Update invincibility timer
     if (invincibilityTimer > 0.0f)
@@ -495,7 +531,7 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
     // Horizontal movement (can't run while crouching or mid-attack)
     if (!isCrouching && !isAttacking && !comboAttack)
     {
-        if (IsKeyDown(KEY_RIGHT) && GetHitbox().x + GetHitbox().width < screenWidth)
+        if (IsKeyDown(KEY_RIGHT) && GetHitbox().x + GetHitbox().width < worldWidth)
         {
             Vector2 oldPos = position;
             position.x += speed;
@@ -522,12 +558,13 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
     // attack input with cooldown and combo extension
     if (IsKeyPressed(KEY_Z))
     {
-        double now = GetTime();
+        double now = GetGameTime();
         if (isAttacking)
         {
             // upgrade to combo (extra frames)
             comboAttack = true;
             animationStartTime = now; // restart timing for full combo anim
+            PlaySfx(SFX_SLASH);
         }
         else if (now >= nextAttackReadyTime)
         {
@@ -535,10 +572,11 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
             comboAttack = false;
             animationStartTime = now;
             hasDealtDamage = false; // Reset damage flag for new attack (only on fresh attack start)
+            PlaySfx(SFX_SLASH);
         }
     }
     // Apply gravity
-    float deltaTime2 = GetFrameTime();
+    float deltaTime2 = GetGameFrameTime();
     speedY += GRAVITY * deltaTime2;
 
     // Update falling through timer
@@ -569,7 +607,7 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
         speedY = JUMP_VELOCITY;
         isJumping = true;
         isOnGround = false;
-        animationStartTime = GetTime();
+        animationStartTime = GetGameTime();
     }
 
     // Update vertical position
@@ -590,9 +628,9 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
     }
 
     // Prevent falling through bottom of screen
-    if (position.y + height >= screenHeight)
+    if (position.y + height >= worldHeight)
     {
-        position.y = screenHeight - height;
+        position.y = worldHeight - height;
         speedY = 0.0f;
         isOnGround = true;
         isLanding = false;
@@ -603,14 +641,14 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
     {
         if (isJumping)
         {
-            animationStartTime = GetTime();
+            animationStartTime = GetGameTime();
         }
         isJumping = false;
         speedY = 0.0f;
 
         if (isLanding)
         {
-            animationStartTime = GetTime();
+            animationStartTime = GetGameTime();
         }
         isLanding = false;
     }
@@ -624,7 +662,7 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
     static bool wasCrouching = false;
     if (isCrouching && !wasCrouching)
     {
-        animationStartTime = GetTime();
+        animationStartTime = GetGameTime();
         wasCrouching = true;
     }
     else if (!isCrouching)
@@ -635,7 +673,7 @@ void Fighter::Update(const std::vector<Platform> &platforms, const std::vector<W
     // finish attack/combo when animation ends and set cooldown
     if (isAttacking || comboAttack)
     {
-        double now = GetTime();
+        double now = GetGameTime();
         float duration = comboAttack ? comboDuration : attackDuration;
         if ((now - animationStartTime) >= duration)
         {
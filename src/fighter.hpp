@@ -11,11 +11,13 @@ class Fighter {
     Fighter();
     ~Fighter();
     void Reset();
+    void UnloadTextures();  // before the window closes; the fighter outlives it in main
     void resetPos();
     void Update(const std::vector<Platform>& platforms, const std::vector<Wall>& walls);
     void Draw();
     Rectangle GetRect() const;
     Rectangle GetHitbox() const;
+    Rectangle GetHurtbox() const;
     Rectangle GetAttackHitbox() const;
     void characterDeath(const std::vector<Enemy*>& enemies);
     void PerformSlash(Enemy& enemy);
@@ -28,8 +30,15 @@ class Fighter {
     float baseDamage;
     float comboDamage;
     int speed;
+
+    // Movement physics; the level generator builds its layouts from these so every platform is reachable
+    static constexpr float GRAVITY = 800.0f;
+    static constexpr float JUMP_VELOCITY = -500.0f;
+    static constexpr int RUN_SPEED = 5;     // pixels per frame
     
     private:
+    friend struct BenchAccess;  // tools/bench.cpp times the collision helpers directly
+
     Texture2D fighterSet1;
     Texture2D fighterSet2;
     AtlasInfo atlas;
@@ -73,6 +82,7 @@ class Fighter {
     bool hasDealtDamage; // Track if damage was dealt this attack to prevent multiple hits
     float attackHitboxDelay; // Delay before attack hitbox becomes active (1 second)
     
+    const spriteAnimation& CurrentAnimation() const;
     bool CheckPlatformCollision(const std::vector<Platform>& platforms);
     bool CheckWallCollision(const std::vector<Wall>& walls);
 };
\ No newline at end of file
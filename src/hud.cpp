@@ -0,0 +1,131 @@
+#include "hud.hpp"
+#include "bringerofdeath.hpp"
+#include "render.hpp"
+#include "trace.hpp"
+#include <cstdio>
+#include <cstring>
+
+static const float BOSS_BAR_WIDTH = 900.0f;
+static const float BOSS_BAR_HEIGHT = 8.0f;
+static const float BOSS_BAR_Y = 120.0f;
+
+HudText::HudText()
+{
+    font = {0};
+    fontSize = 0.0f;
+    spacing = 0.0f;
+    text[0] = '\0';
+    glyphCount = 0;
+    size = {0, 0};
+}
+
+void HudText::Init(Font font, float fontSize, float spacing)
+{
+    this->font = font;
+    this->fontSize = fontSize;
+    this->spacing = spacing;
+    text[0] = '\0';
+    glyphCount = 0;
+    size = {0, 0};
+}
+
+bool HudText::Set(const char* newText)
+{
+    if (strncmp(text, newText, MAX_LENGTH) == 0) {
+        return false;
+    }
+    strncpy(text, newText, MAX_LENGTH);
+    text[MAX_LENGTH] = '\0';
+
+    // Same placement rules as DrawTextEx, resolved once (HUD strings are ASCII)
+    float scale = fontSize / (float)font.baseSize;
+    float x = 0.0f;
+    glyphCount = 0;
+    for (int i = 0; text[i] != '\0'; i++) {
+        int codepoint = (unsigned char)text[i];
+        int index = GetGlyphIndex(font, codepoint);
+        if (codepoint != ' ' && codepoint != '\t') {
+            codepoints[glyphCount] = codepoint;
+            offsets[glyphCount] = {x, 0.0f};
+            glyphCount++;
+        }
+        float advance = (font.glyphs[index].advanceX == 0) ? font.recs[index].width : (float)font.glyphs[index].advanceX;
+        x += advance * scale + spacing;
+    }
+    size = MeasureTextEx(font, text, fontSize, spacing);
+    return true;
+}
+
+void HudText::Draw(Vector2 position, Color tint) const
+{
+    for (int i = 0; i < glyphCount; i++) {
+        GetRenderBackend().DrawTextCodepoint(font, codepoints[i], {position.x + offsets[i].x, position.y + offsets[i].y}, fontSize, tint);
+    }
+}
+
+Hud::Hud()
+{
+    lives = -1;
+    stageLabel = nullptr;
+    boss = nullptr;
+    bossBarFill = -1;
+    bossBarColor = GREEN;
+}
+
+void Hud::Init(Font font, float fontSize, float spacing)
+{
+    livesText.Init(font, fontSize, spacing);
+    stageText.Init(font, fontSize, spacing);
+    bossNameText.Init(font, fontSize * 1.75f, spacing);
+    bossNameText.Set("BRINGER OF DEATH");
+    lives = -1;
+    stageLabel = nullptr;
+}
+
+void Hud::SetBoss(const Boss* newBoss)
+{
+    boss = newBoss;
+    bossBarFill = -1;
+}
+
+void Hud::Update(int newLives, const char* newStageLabel)
+{
+    if (newLives != lives) {
+        char buffer[32];
+        snprintf(buffer, sizeof(buffer), "Lives: %d", newLives);
+        livesText.Set(buffer);
+        lives = newLives;
+    }
+    if (newStageLabel != stageLabel) {
+        stageText.Set(newStageLabel);
+        stageLabel = newStageLabel;
+    }
+
+    if (boss != nullptr && !boss->IsDead()) {
+        float healthPercent = boss->GetHealth() / boss->GetMaxHealth();
+        int fill = (int)(BOSS_BAR_WIDTH * healthPercent);
+        if (fill != bossBarFill) {
+            bossBarFill = fill;
+            // Health bar colour steps from green to red as health drops
+            bossBarColor = healthPercent > 0.5f ? GREEN : (healthPercent > 0.25f ? YELLOW : RED);
+        }
+    }
+}
+
+void Hud::Draw(int screenWidth) const
+{
+    TRACE_ZONE("Hud::Draw");
+    livesText.Draw({50.0f, 20.0f}, WHITE);
+    stageText.Draw({(float)screenWidth - stageText.GetSize().x - 50.0f, 20.0f}, WHITE);
+
+    if (boss == nullptr || boss->IsDead()) return;
+
+    float barX = (screenWidth - BOSS_BAR_WIDTH) / 2.0f;
+    RenderBackend& gfx = GetRenderBackend();
+    gfx.DrawRectangle(barX, BOSS_BAR_Y, BOSS_BAR_WIDTH, BOSS_BAR_HEIGHT, DARKGRAY);
+    gfx.DrawRectangle(barX, BOSS_BAR_Y, bossBarFill, BOSS_BAR_HEIGHT, bossBarColor);
+    gfx.DrawRectangleLines(barX, BOSS_BAR_Y, BOSS_BAR_WIDTH, BOSS_BAR_HEIGHT, WHITE);
+
+    Vector2 nameSize = bossNameText.GetSize();
+    bossNameText.Draw({barX + (BOSS_BAR_WIDTH - nameSize.x) / 2.0f, BOSS_BAR_Y - nameSize.y - 5.0f}, RED);
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include <raylib.h>
+
+class Boss;
+
+// Text item whose glyph layout is built once and rebuilt only when its content changes
+class HudText {
+public:
+    static constexpr int MAX_LENGTH = 63;
+
+    HudText();
+    void Init(Font font, float fontSize, float spacing);
+    bool Set(const char* newText);  // returns true when the layout was rebuilt
+    Vector2 GetSize() const { return size; }
+    void Draw(Vector2 position, Color tint) const;
+
+private:
+    Font font;
+    float fontSize;
+    float spacing;
+    char text[MAX_LENGTH + 1];
+    int glyphCount;
+    int codepoints[MAX_LENGTH];
+    Vector2 offsets[MAX_LENGTH];
+    Vector2 size;
+};
+
+// Gameplay HUD: lives, stage label and boss health bar. Steady-state frames compare cached
+// values only; no strings are built and nothing is measured unless a value changes.
+class Hud {
+public:
+    Hud();
+    void Init(Font font, float fontSize, float spacing);
+    void SetBoss(const Boss* boss);
+    void Update(int lives, const char* stageLabel);
+    void Draw(int screenWidth) const;
+
+private:
+    HudText livesText;
+    HudText stageText;
+    HudText bossNameText;
+    int lives;
+    const char* stageLabel;
+
+    const Boss* boss;
+    int bossBarFill;      // filled width of the health bar in pixels (the health bucket)
+    Color bossBarColor;
+};
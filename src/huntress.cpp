@@ -1,6 +1,15 @@
 #include "huntress.hpp"
 #include "animation.h"
 #include "fighter.hpp"
+#include "world.hpp"
+#include "particles.hpp"
+#include "sfx.hpp"
+#include "render.hpp"
+#include "textures.hpp"
+#include "loadtimes.hpp"
+#include "tilemap.hpp"
+#include "perfoverlay.hpp"
+#include "trace.hpp"
 #include <algorithm>
 
 // static AnimDef ATTACK1  = {0, 0, 5, 10}; 
@@ -14,55 +23,42 @@ static AnimDef IDLE  = {7, 0, 8, 10};
 static AnimDef RUN  = {8, 0, 8, 10};
 static AnimDef SPEAR= {0, 0, 4, 10};
 
-// Initialize static textures
-Texture2D Huntress::sharedAtlas = {0};
-Texture2D Huntress::spearAtlas = {0};
+const TextureAsset Huntress::SHEET = {"resources/enemies/Huntress/Sprites/huntress_spritesheet.png", 150, 150};
+const TextureAsset Huntress::SPEAR_SHEET = {"resources/enemies/Huntress/Sprites/Spear move.png", 0, 0};
 
-void Huntress::LoadSharedTexture()
-{
-    if (sharedAtlas.id == 0) {
-        sharedAtlas = LoadTexture("resources/enemies/Huntress/Sprites/huntress_spritesheet.png");
-    }
-}
-
-void Huntress::UnloadSharedTexture()
-{
-    if (sharedAtlas.id != 0) {
-        UnloadTexture(sharedAtlas);
-        sharedAtlas = {0};
-    }
-}
+static Rectangle SPEAR_FRAMES[] = {
+    {0, 0, 60, 20},
+    {60, 0, 60, 20},
+    {120, 0, 60, 20},
+    {180, 0, 60, 20},
+};
 
 Huntress::Huntress()
 {
-    LoadSharedTexture();
+    LoadTimer timer(LOAD_PHASE, "construct/Huntress");
+    atlas = AcquireAsset(SHEET);
 
     textureWidth  = 150;
     textureHeight = 150;
 
     atlasInfo.frameWidth  = textureWidth;
     atlasInfo.frameHeight = textureHeight;
-    atlasInfo.columns     = sharedAtlas.width / textureWidth;
-
-    // attack1Anim  = LoadAnim(ATTACK1,  sharedAtlas, atlasInfo, offsetX, offsetY, false);
-    // attack2Anim  = LoadAnim(ATTACK2,  sharedAtlas, atlasInfo, offsetX, offsetY, false);
-    attack3Anim  = LoadAnim(ATTACK3,  sharedAtlas, atlasInfo, false);
-    hurtAnim = LoadAnim(HURT, sharedAtlas, atlasInfo, false);
-    dieAnim  = LoadAnim(DEATH,  sharedAtlas, atlasInfo, false);
-    jumpAnim  = LoadAnim(JUMP,  sharedAtlas, atlasInfo, false);
-    fallAnim  = LoadAnim(FALL,  sharedAtlas, atlasInfo, false);
-    idleAnim = LoadAnim(IDLE, sharedAtlas, atlasInfo, true);
-    runAnim = LoadAnim(RUN, sharedAtlas, atlasInfo, true);
-
-    spearAtlas = LoadTexture("resources/enemies/Huntress/Sprites/Spear move.png");
-    spearAnim = CreateSpriteAnimation(spearAtlas, 10, (Rectangle[]){
-        (Rectangle){0, 0, 60, 20},
-        (Rectangle){60, 0, 60, 20},
-        (Rectangle){120, 0, 60, 20},
-        (Rectangle){180, 0, 60, 20},
-    }, 4, true);
-
-    position = { 250.0f, (float)GetScreenHeight() - 950.0f };
+    atlasInfo.columns     = atlas.width / textureWidth;
+
+    // attack1Anim  = LoadAnim(ATTACK1,  atlas, atlasInfo, offsetX, offsetY, false);
+    // attack2Anim  = LoadAnim(ATTACK2,  atlas, atlasInfo, offsetX, offsetY, false);
+    attack3Anim  = LoadAnim(ATTACK3,  atlas, atlasInfo, false);
+    hurtAnim = LoadAnim(HURT, atlas, atlasInfo, false);
+    dieAnim  = LoadAnim(DEATH,  atlas, atlasInfo, false);
+    jumpAnim  = LoadAnim(JUMP,  atlas, atlasInfo, false);
+    fallAnim  = LoadAnim(FALL,  atlas, atlasInfo, false);
+    idleAnim = LoadAnim(IDLE, atlas, atlasInfo, true);
+    runAnim = LoadAnim(RUN, atlas, atlasInfo, true);
+
+    spearAtlas = AcquireAsset(SPEAR_SHEET);
+    spearAnim = CreateSpriteAnimation(spearAtlas, 10, SPEAR_FRAMES, 4, true);
+
+    position = { 250.0f, GetWorldHeight() - 950.0f };
     scale = 2.5f;
     width = (int)(textureWidth * scale);
     height = (int)(textureHeight * scale);
@@ -87,7 +83,7 @@ Huntress::Huntress()
 
     state = State::Idle;
     lastState = State::Idle;
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
     attack3StartTime = 0.0f;
     attack3Cooldown = 0.0f;
     attack3ProjectileFired = false;
@@ -111,8 +107,8 @@ Huntress::~Huntress()
     DisposeSpriteAnimation(fallAnim);
     DisposeSpriteAnimation(idleAnim);
     DisposeSpriteAnimation(runAnim);
-    UnloadTexture(spearAtlas);
-    // Do not unload shared texture - managed by LoadSharedTexture/UnloadSharedTexture
+    ReleaseTexture(atlas);
+    ReleaseTexture(spearAtlas);
 }
 
 Rectangle Huntress::GetRect() const
@@ -120,8 +116,9 @@ Rectangle Huntress::GetRect() const
     return Rectangle{ position.x, position.y, (float)width, (float)height };
 }
 
-Rectangle Huntress::GetHitbox() const
+Rectangle Huntress::GetBodyBox() const
 {
+    // Fixed physics box used for platform collision and AI
     float x = position.x + HITBOX_OFFSET_X;
     float y = position.y + HITBOX_OFFSET_Y;
     float w = (float)width - HITBOX_OFFSET_X * 2.0f;
@@ -129,21 +126,40 @@ Rectangle Huntress::GetHitbox() const
     return Rectangle{x, y, w, h};
 }
 
+Rectangle Huntress::GetHitbox() const
+{
+    // Combat box follows the opaque bounds of the current animation frame
+    float elapsed = GetGameTime() - animationStartTime;
+    return GetSpriteAnimationBox(CurrentAnimation(), GetRect(), facingRight, elapsed);
+}
+
 float Huntress::GetFeetY() const
 {
-    Rectangle hit = GetHitbox();
+    Rectangle hit = GetBodyBox();
     return hit.y + hit.height;
 }
 
 bool Huntress::CheckPlatformCollision(const std::vector<Platform>& platforms, Rectangle* platformHit)
 {
-    Rectangle rect = GetHitbox();
+    Rectangle rect = GetBodyBox();
     bool grounded = false;
     if (platformHit) {
         *platformHit = {0.0f, 0.0f, 0.0f, 0.0f};
     }
 
+    const TileMap* tiles = GetActiveTileMap();
+    TileSurface surface;
+    if (tiles != nullptr && speedY >= 0 && tiles->FindSurface(rect, false, surface)) {
+        position.y = surface.rect.y - (HITBOX_OFFSET_Y + rect.height);
+        speedY = 0.0f;
+        if (platformHit) {
+            *platformHit = surface.rect;
+        }
+        return true;
+    }
+
     for (const auto& platform : platforms) {
+        CountPerf(PERF_COLLISION_TESTS);
         Rectangle pr = platform.GetRect();
         if (speedY >= 0 && rect.x + rect.width > pr.x && rect.x < pr.x + pr.width) {
             float feetY = rect.y + rect.height;
@@ -167,21 +183,26 @@ void Huntress::TakeDamage(float damageAmount)
     if (isDying || isDeadFinal) return;
     health -= damageAmount;
     state = State::Hurt;
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
+    EmitHitBurst(GetBodyBox(), Color{200, 40, 40, 255});
+    PlaySfx(SFX_HIT);
     if (health <= 0.0f) {
         health = 0.0f;
         isDying = true;
         state = State::Die;
-        animationStartTime = GetTime();
+        animationStartTime = GetGameTime();
+        EmitDeathBurst(GetBodyBox(), Color{200, 40, 40, 255});
+        PlaySfx(SFX_ENEMY_DEATH);
     }
 }
 
 void Huntress::Update(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player)
 {
+    TRACE_ZONE("Huntress::Update");
     const float GRAVITY = 800.0f;
     const float JUMP_VELOCITY = -700.0f;
-    float dt = GetFrameTime();
-    double now = GetTime();
+    float dt = GetGameFrameTime();
+    double now = GetGameTime();
 
     if (isDeadFinal) return;
 
@@ -209,25 +230,25 @@ void Huntress::Update(const std::vector<Platform>& platforms, const std::vector<
         SetState(State::Idle);
     }
 
-    Rectangle hitbox = GetHitbox();
+    Rectangle hitbox = GetBodyBox();
     float feetHeight = HITBOX_OFFSET_Y + hitbox.height;
     float feetY = GetFeetY();
-    int screenH = GetScreenHeight();
-    int screenW = GetScreenWidth();
-    if (feetY >= (float)screenH) {
-        position.y = (float)screenH - feetHeight;
+    float worldH = GetWorldHeight();
+    float worldW = GetWorldWidth();
+    if (feetY >= worldH) {
+        position.y = worldH - feetHeight;
         speedY = 0.0f;
         isOnGround = true;
         hasStandingPlatform = true;
-        standingPlatformRect = {0.0f, (float)screenH - 2.0f, (float)screenW, 4.0f};
-        hitbox = GetHitbox();
+        standingPlatformRect = {0.0f, worldH - 2.0f, worldW, 4.0f};
+        hitbox = GetBodyBox();
     }
 
     float playerCenterX = player.GetHitbox().x + player.GetHitbox().width * 0.5f;
     float myCenterX = hitbox.x + hitbox.width * 0.5f;
 
     if(state == State::Hurt) {
-        float elapsed = GetTime() - animationStartTime;
+        float elapsed = GetGameTime() - animationStartTime;
         if (elapsed >= 0.3f) { // hurt animation duration
             SetState(State::Idle);
         }
@@ -275,7 +296,7 @@ void Huntress::Update(const std::vector<Platform>& platforms, const std::vector<
             idleTimer -= dt;
         }
 
-        hitbox = GetHitbox();
+        hitbox = GetBodyBox();
 
         if (isOnGround) {
             bool jumped = false;
@@ -308,12 +329,11 @@ void Huntress::Update(const std::vector<Platform>& platforms, const std::vector<
                 Rectangle nextHitbox = hitbox;
                 nextHitbox.x += step;
 
-                // Check screen edges
-                int screenW = GetScreenWidth();
-                bool atScreenEdge = (nextHitbox.x <= 0.0f) || (nextHitbox.x + nextHitbox.width >= (float)screenW);
+                // Check world edges
+                bool atWorldEdge = (nextHitbox.x <= 0.0f) || (nextHitbox.x + nextHitbox.width >= worldW);
                 
-                if (atScreenEdge) {
-                    // Flip direction at screen edge
+                if (atWorldEdge) {
+                    // Flip direction at world edge
                     moveDir *= -1;
                     directionChangeCooldown = 5.0f;
                     directionChanges++;
@@ -354,7 +374,7 @@ void Huntress::Update(const std::vector<Platform>& platforms, const std::vector<
             }
         }
 
-        hitbox = GetHitbox();
+        hitbox = GetBodyBox();
         myCenterX = hitbox.x + hitbox.width * 0.5f;
 
         if (isOnGround && attack3Cooldown <= 0.0f) {
@@ -376,50 +396,18 @@ void Huntress::Update(const std::vector<Platform>& platforms, const std::vector<
 
 void Huntress::Draw()
 {
+    TRACE_ZONE("Huntress::Draw");
     if (isDeadFinal) return;
-    float elapsed = GetTime() - animationStartTime;
+    float elapsed = GetGameTime() - animationStartTime;
     Vector2 origin{0,0};
-    Rectangle dest = GetRect();
-    Rectangle spearDest = GetRect();
-    spearDest.x += facingRight ? GetHitbox().width : -20.0f;
-    spearDest.y += dest.height * 0.4f;
 
     // DrawRectangleLinesEx(GetHitbox(), 1.0f, RED); // Debug: draw hitbox
 
-    switch (state) {
-        // case State::Attack1:
-        //     DrawSpriteAnimationPro(attack1Anim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-        //     break;
-        // case State::Attack2:
-        //     DrawSpriteAnimationPro(attack2Anim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-        //     break;
-        case State::Attack3:
-            DrawSpriteAnimationPro(attack3Anim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            // DrawSpriteAnimationPro(spearAnim, spearDest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Hurt:
-            DrawSpriteAnimationPro(hurtAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Die:
-            DrawSpriteAnimationPro(dieAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Jump:
-            DrawSpriteAnimationPro(jumpAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Fall:
-            DrawSpriteAnimationPro(fallAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Idle:
-            DrawSpriteAnimationPro(idleAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Walk:
-            DrawSpriteAnimationPro(runAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-    }
+    DrawSpriteAnimationPro(CurrentAnimation(), GetRect(), origin, 0.0f, WHITE, facingRight, elapsed);
 
     // Draw active spears
     for (const auto& spear : spears) {
-        if (spear.alive) {
+        if (spear.alive && IsInWorldView(spear.GetRect())) {
             DrawSpriteAnimationPro(spearAnim, spear.GetRect(), origin, 0.0f, WHITE, spear.speedX > 0.0f, elapsed);
             // DrawRectangleLinesEx(spear.GetRect(), 2.0f, YELLOW); // Debug: draw spear hitbox
         }
@@ -427,11 +415,24 @@ void Huntress::Draw()
 
 }
 
+const spriteAnimation& Huntress::CurrentAnimation() const
+{
+    switch (state) {
+        case State::Attack3: return attack3Anim;
+        case State::Hurt:    return hurtAnim;
+        case State::Die:     return dieAnim;
+        case State::Jump:    return jumpAnim;
+        case State::Fall:    return fallAnim;
+        case State::Walk:    return runAnim;
+        default:             return idleAnim;
+    }
+}
+
 void Huntress::SetState(State newState)
 {
     if (state != newState) {
         state = newState;
-        animationStartTime = GetTime();
+        animationStartTime = GetGameTime();
         lastState = newState;
     }
 }
@@ -458,11 +459,14 @@ void Huntress::SpawnSpear()
     newSpear.alive = true;
     
     spears.push_back(newSpear);
+    PlaySfx(SFX_SPEAR_THROW);
 }
 
 void Huntress::UpdateSpear(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player)
 {
-    float dt = GetFrameTime();
+    TRACE_ZONE("Huntress::UpdateSpear");
+    float dt = GetGameFrameTime();
+    CountPerf(PERF_SPEARS, (int)spears.size());
     
     // Update each active spear
     for (auto it = spears.begin(); it != spears.end(); ) {
@@ -479,6 +483,7 @@ void Huntress::UpdateSpear(const std::vector<Platform>& platforms, const std::ve
         Rectangle spearRect = it->GetRect();
         
         for (const auto& platform : platforms) {
+            CountPerf(PERF_COLLISION_TESTS);
             Rectangle platformRect = platform.GetRect();
             if (CheckCollisionRecs(spearRect, platformRect)) {
                 collided = true;
@@ -486,14 +491,23 @@ void Huntress::UpdateSpear(const std::vector<Platform>& platforms, const std::ve
             }
         }
         
+        // Solid tiles stop spears like walls
+        Rectangle tileHit;
+        const TileMap* tiles = GetActiveTileMap();
+        if (!collided && tiles != nullptr && tiles->FindSolidOverlap(spearRect, tileHit)) {
+            collided = true;
+        }
+
         // Check collision with walls
         if (!collided) {
-            Rectangle playerRect = player.GetRect();
+            Rectangle playerRect = player.GetHurtbox();
+            CountPerf(PERF_COLLISION_TESTS);
             if (CheckCollisionRecs(spearRect, playerRect)) {
                 collided = true;
                 break;
             }
             for (const auto& wall : walls) {
+                CountPerf(PERF_COLLISION_TESTS);
                 Rectangle wallRect = wall.GetRect();
                 if (CheckCollisionRecs(spearRect, wallRect)) {
                     collided = true;
@@ -502,8 +516,15 @@ void Huntress::UpdateSpear(const std::vector<Platform>& platforms, const std::ve
             }
         }
         
-        // Remove spear if it hit something or left screen
-        if (collided || it->position.x < 0 || it->position.x > GetScreenWidth()) {
+        // Remove spear if it hit something or left the world
+        if (collided || it->position.x < 0 || it->position.x > GetWorldWidth()) {
+            if (collided) {
+                // Splinters thrown back against the direction of flight
+                float back = (it->speedX > 0) ? PI : 0.0f;
+                Vector2 tip = {(it->speedX > 0) ? spearRect.x + spearRect.width : spearRect.x, spearRect.y + spearRect.height * 0.5f};
+                EmitParticles(ParticleBurst{tip, 32, Color{230, 210, 160, 255}, 360.0f, PI * 0.35f, back, 0.35f, 4.0f, 900.0f});
+                PlaySfx(SFX_SPEAR_IMPACT);
+            }
             it->alive = false;
             it = spears.erase(it);
         } else {
@@ -4,6 +4,7 @@
 #include "platform.hpp"
 #include "animation.h"
 #include "enemy.hpp"
+#include "textures.hpp"
 
 // class Fighter; // forward declaration
 
@@ -34,13 +35,16 @@ public:
     void TakeDamage(float damageAmount) override;
     bool IsDead() const override { return isDeadFinal; }
     float GetHealth() const override { return health; }
-    void LoadSharedTexture();
-    void UnloadSharedTexture();
+    void RestoreHealth(float value) override { health = value; }
+    static const TextureAsset SHEET;    // kept resident by the level asset sets
+    static const TextureAsset SPEAR_SHEET;
     const std::vector<Spear>& GetSpears() const { return spears; }
 
 private:
-    static Texture2D sharedAtlas;
-    static Texture2D spearAtlas;
+    friend struct BenchAccess;  // tools/bench.cpp times the collision helpers directly
+
+    Texture2D atlas;
+    Texture2D spearAtlas;
     static constexpr float HITBOX_OFFSET_X = 135.0f;
     static constexpr float HITBOX_OFFSET_Y = 133.0f;
     AtlasInfo atlasInfo;
@@ -98,6 +102,8 @@ private:
     std::vector<Spear> spears;   // Active spears in flight
 
     void SetState(State newState);
+    const spriteAnimation& CurrentAnimation() const;
+    Rectangle GetBodyBox() const;
     bool CheckPlatformCollision(const std::vector<Platform>& platforms, Rectangle* platformHit);
     float GetFeetY() const;
     void SpawnSpear();
@@ -0,0 +1,370 @@
+#include "level.hpp"
+#include "mushroom.hpp"
+#include "slime.hpp"
+#include "huntress.hpp"
+#include "bringerofdeath.hpp"
+#include "loadtimes.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+static const char* ENEMY_KIND_NAMES[ENEMY_KIND_COUNT] = { "mushroom", "slime", "huntress", "boss" };
+static const char* TILE_COLLISION_NAMES[] = { "empty", "platform", "ground", "solid" };
+
+// Binary layout: header, then platform, wall, spawn and tile run records back to back
+static const uint32_t LEVEL_MAGIC = 0x4256454c;    // "LEVB"
+static const uint32_t LEVEL_VERSION = 2;
+static const int LEVEL_NAME_SIZE = 16;
+
+struct LevelFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    float width;
+    float height;
+    uint32_t platformCount;
+    uint32_t wallCount;
+    uint32_t spawnCount;
+    char music[LEVEL_NAME_SIZE];
+    char background[LEVEL_NAME_SIZE];
+    uint32_t tileColumns;
+    uint32_t tileRows;
+    uint32_t tileSize;
+    uint32_t tileRunCount;
+};
+
+struct LevelFileRect {
+    float x, y, width, height;
+    uint32_t flag;          // ground for platforms, standable top for walls
+};
+
+struct LevelFileSpawn {
+    uint32_t kind;
+    float x, y;
+};
+
+const char* GetEnemyKindName(EnemyKind kind)
+{
+    return (kind >= 0 && kind < ENEMY_KIND_COUNT) ? ENEMY_KIND_NAMES[kind] : "unknown";
+}
+
+// Minimal tokenizer over a buffer that is not null terminated
+struct LineReader {
+    const char* cursor;
+    const char* end;
+
+    void SkipBlanks()
+    {
+        while (cursor < end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\r')) cursor++;
+    }
+
+    bool AtLineEnd()
+    {
+        SkipBlanks();
+        return cursor >= end || *cursor == '\n' || *cursor == '#';
+    }
+
+    void NextLine()
+    {
+        while (cursor < end && *cursor != '\n') cursor++;
+        if (cursor < end) cursor++;
+    }
+
+    bool Word(const char*& start, int& length)
+    {
+        if (AtLineEnd()) return false;
+        start = cursor;
+        while (cursor < end && *cursor > ' ' && *cursor != '#') cursor++;
+        length = (int)(cursor - start);
+        return true;
+    }
+
+    bool Number(float& value)
+    {
+        if (AtLineEnd()) return false;
+        bool negative = (*cursor == '-');
+        if (*cursor == '-' || *cursor == '+') cursor++;
+        const char* digits = cursor;
+        float result = 0.0f;
+        while (cursor < end && *cursor >= '0' && *cursor <= '9') result = result * 10.0f + (float)(*cursor++ - '0');
+        if (cursor < end && *cursor == '.') {
+            cursor++;
+            float scale = 0.1f;
+            while (cursor < end && *cursor >= '0' && *cursor <= '9') {
+                result += (float)(*cursor++ - '0') * scale;
+                scale *= 0.1f;
+            }
+        }
+        if (cursor == digits) return false;
+        value = negative ? -result : result;
+        return true;
+    }
+};
+
+static bool WordIs(const char* word, int length, const char* keyword)
+{
+    return (int)strlen(keyword) == length && memcmp(word, keyword, length) == 0;
+}
+
+static void ClearLevel(LevelData& level)
+{
+    level.width = 0.0f;
+    level.height = 0.0f;
+    level.music.clear();
+    level.background.clear();
+    level.platforms.clear();
+    level.walls.clear();
+    level.spawns.clear();
+    level.tiles.Clear();
+}
+
+bool ParseLevelText(const char* text, int length, const char* sourceName, LevelData& level)
+{
+    ClearLevel(level);
+
+    // Count first so the containers are sized once
+    int platformCount = 0, wallCount = 0, spawnCount = 0;
+    LineReader reader = { text, text + length };
+    while (reader.cursor < reader.end) {
+        const char* word;
+        int wordLength;
+        if (reader.Word(word, wordLength)) {
+            if (WordIs(word, wordLength, "platform") || WordIs(word, wordLength, "ground")) platformCount++;
+            else if (WordIs(word, wordLength, "wall")) wallCount++;
+            else if (WordIs(word, wordLength, "spawn")) spawnCount++;
+        }
+        reader.NextLine();
+    }
+    level.platforms.reserve(platformCount);
+    level.walls.reserve(wallCount);
+    level.spawns.reserve(spawnCount);
+
+    reader = { text, text + length };
+    for (int line = 1; reader.cursor < reader.end; line++, reader.NextLine()) {
+        const char* word;
+        int wordLength;
+        if (!reader.Word(word, wordLength)) continue;
+
+        bool ok = true;
+        if (WordIs(word, wordLength, "size")) {
+            ok = reader.Number(level.width) && reader.Number(level.height);
+        }
+        else if (WordIs(word, wordLength, "music") || WordIs(word, wordLength, "background")) {
+            const char* name;
+            int nameLength;
+            ok = reader.Word(name, nameLength) && nameLength < LEVEL_NAME_SIZE;
+            if (ok) (word[0] == 'm' ? level.music : level.background).assign(name, nameLength);
+        }
+        else if (WordIs(word, wordLength, "platform") || WordIs(word, wordLength, "ground") || WordIs(word, wordLength, "wall")) {
+            float x, y, width, height;
+            ok = reader.Number(x) && reader.Number(y) && reader.Number(width) && reader.Number(height);
+            if (ok && word[0] == 'w') {
+                const char* option;
+                int optionLength;
+                bool solid = reader.Word(option, optionLength) && WordIs(option, optionLength, "solid");
+                level.walls.push_back(Wall(x, y, width, height, !solid));
+            } else if (ok) {
+                level.platforms.push_back(Platform(x, y, width, height, word[0] == 'g'));
+            }
+        }
+        else if (WordIs(word, wordLength, "spawn")) {
+            const char* name;
+            int nameLength;
+            int kind = ENEMY_KIND_COUNT;
+            if (reader.Word(name, nameLength)) {
+                for (kind = 0; kind < ENEMY_KIND_COUNT; kind++) {
+                    if (WordIs(name, nameLength, ENEMY_KIND_NAMES[kind])) break;
+                }
+            }
+            float x, y;
+            ok = kind < ENEMY_KIND_COUNT && reader.Number(x) && reader.Number(y);
+            if (ok) level.spawns.push_back(EnemySpawn{(EnemyKind)kind, {x, y}});
+        }
+        else if (WordIs(word, wordLength, "tilemap")) {
+            float columns, rows, size = (float)TileMap::TILESET_TILE_SIZE;
+            ok = reader.Number(columns) && reader.Number(rows) && columns >= 1.0f && rows >= 1.0f;
+            if (ok && !reader.AtLineEnd()) ok = reader.Number(size) && size >= 1.0f;
+            ok = ok && level.tiles.Reset((int)columns, (int)rows, (int)size);
+        }
+        else if (WordIs(word, wordLength, "tiles")) {
+            float col, row, count, tile;
+            const char* name;
+            int nameLength;
+            int kind = TILE_SOLID + 1;
+            ok = !level.tiles.IsEmpty() && reader.Number(col) && reader.Number(row) && reader.Number(count) &&
+                 reader.Number(tile) && reader.Word(name, nameLength);
+            if (ok) {
+                for (kind = TILE_EMPTY; kind <= TILE_SOLID; kind++) {
+                    if (WordIs(name, nameLength, TILE_COLLISION_NAMES[kind])) break;
+                }
+                ok = kind <= TILE_SOLID;
+            }
+            for (int i = 0; ok && i < (int)count; i++) {
+                level.tiles.SetTile((int)col + i, (int)row, (int)tile, (TileCollision)kind);
+            }
+        }
+        else {
+            ok = false;
+        }
+
+        if (!ok) {
+            TraceLog(LOG_WARNING, "LEVEL: %s:%i: cannot read '%.*s' line", sourceName, line, wordLength, word);
+            return false;
+        }
+    }
+
+    if (level.width <= 0.0f || level.height <= 0.0f) {
+        TraceLog(LOG_WARNING, "LEVEL: %s: missing size", sourceName);
+        return false;
+    }
+    return true;
+}
+
+static bool ParseLevelBinary(const unsigned char* data, int length, const char* sourceName, LevelData& level)
+{
+    ClearLevel(level);
+
+    LevelFileHeader header;
+    if (length < (int)sizeof(header)) return false;
+    memcpy(&header, data, sizeof(header));
+    // No count can exceed what the file could hold, which also keeps the size sum below from overflowing
+    size_t size = (size_t)length;
+    bool countsFit = header.platformCount <= size / sizeof(LevelFileRect) && header.wallCount <= size / sizeof(LevelFileRect) &&
+                     header.spawnCount <= size / sizeof(LevelFileSpawn) && header.tileRunCount <= size / sizeof(TileRun);
+    size_t expected = sizeof(header) + ((size_t)header.platformCount + (size_t)header.wallCount) * sizeof(LevelFileRect) +
+                      (size_t)header.spawnCount * sizeof(LevelFileSpawn) + (size_t)header.tileRunCount * sizeof(TileRun);
+    if (header.magic != LEVEL_MAGIC || header.version != LEVEL_VERSION || !countsFit || size != expected) {
+        TraceLog(LOG_WARNING, "LEVEL: %s is not a version %u binary level", sourceName, LEVEL_VERSION);
+        return false;
+    }
+
+    level.width = header.width;
+    level.height = header.height;
+    level.music.assign(header.music, strnlen(header.music, LEVEL_NAME_SIZE));
+    level.background.assign(header.background, strnlen(header.background, LEVEL_NAME_SIZE));
+    level.platforms.reserve(header.platformCount);
+    level.walls.reserve(header.wallCount);
+    level.spawns.reserve(header.spawnCount);
+
+    const unsigned char* cursor = data + sizeof(header);
+    for (uint32_t i = 0; i < header.platformCount; i++, cursor += sizeof(LevelFileRect)) {
+        LevelFileRect rect;
+        memcpy(&rect, cursor, sizeof(rect));
+        level.platforms.push_back(Platform(rect.x, rect.y, rect.width, rect.height, rect.flag != 0));
+    }
+    for (uint32_t i = 0; i < header.wallCount; i++, cursor += sizeof(LevelFileRect)) {
+        LevelFileRect rect;
+        memcpy(&rect, cursor, sizeof(rect));
+        level.walls.push_back(Wall(rect.x, rect.y, rect.width, rect.height, rect.flag != 0));
+    }
+    for (uint32_t i = 0; i < header.spawnCount; i++, cursor += sizeof(LevelFileSpawn)) {
+        LevelFileSpawn spawn;
+        memcpy(&spawn, cursor, sizeof(spawn));
+        if (spawn.kind >= ENEMY_KIND_COUNT) continue;
+        level.spawns.push_back(EnemySpawn{(EnemyKind)spawn.kind, {spawn.x, spawn.y}});
+    }
+    if (header.tileRunCount > 0) {
+        std::vector<TileRun> runs(header.tileRunCount);
+        memcpy(runs.data(), cursor, runs.size() * sizeof(TileRun));
+        if (!level.tiles.Reset((int)header.tileColumns, (int)header.tileRows, (int)header.tileSize) ||
+            !level.tiles.DecodeRuns(runs.data(), (int)runs.size())) {
+            TraceLog(LOG_WARNING, "LEVEL: %s has a malformed tile layer", sourceName);
+            level.tiles.Clear();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LoadLevel(const char* fileName, LevelData& level)
+{
+    LoadTimer timer(LOAD_PHASE, "setup/LoadLevel");
+    int length = 0;
+    unsigned char* data = LoadFileData(fileName, &length);
+    if (data == NULL) {
+        ClearLevel(level);
+        return false;
+    }
+
+    bool loaded = IsFileExtension(fileName, ".lvb") ? ParseLevelBinary(data, length, fileName, level)
+                                                    : ParseLevelText((const char*)data, length, fileName, level);
+    UnloadFileData(data);
+    if (loaded) {
+        TraceLog(LOG_INFO, "LEVEL: %s: %i platforms, %i walls, %i spawns, %ix%i tiles", fileName,
+                 (int)level.platforms.size(), (int)level.walls.size(), (int)level.spawns.size(),
+                 level.tiles.GetColumns(), level.tiles.GetRows());
+    }
+    return loaded;
+}
+
+bool SaveLevelBinary(const char* fileName, const LevelData& level)
+{
+    LevelFileHeader header = {};
+    header.magic = LEVEL_MAGIC;
+    header.version = LEVEL_VERSION;
+    header.width = level.width;
+    header.height = level.height;
+    header.platformCount = (uint32_t)level.platforms.size();
+    header.wallCount = (uint32_t)level.walls.size();
+    header.spawnCount = (uint32_t)level.spawns.size();
+    strncpy(header.music, level.music.c_str(), LEVEL_NAME_SIZE - 1);
+    strncpy(header.background, level.background.c_str(), LEVEL_NAME_SIZE - 1);
+
+    std::vector<TileRun> runs;
+    level.tiles.EncodeRuns(runs);
+    header.tileColumns = (uint32_t)level.tiles.GetColumns();
+    header.tileRows = (uint32_t)level.tiles.GetRows();
+    header.tileSize = (uint32_t)level.tiles.GetTileSize();
+    header.tileRunCount = (uint32_t)runs.size();
+
+    std::vector<unsigned char> data(sizeof(header));
+    memcpy(data.data(), &header, sizeof(header));
+    auto append = [&data](const void* record, size_t size) {
+        const unsigned char* bytes = (const unsigned char*)record;
+        data.insert(data.end(), bytes, bytes + size);
+    };
+    for (const auto& platform : level.platforms) {
+        Rectangle r = platform.GetRect();
+        LevelFileRect rect = { r.x, r.y, r.width, r.height, platform.IsGround() ? 1u : 0u };
+        append(&rect, sizeof(rect));
+    }
+    for (const auto& wall : level.walls) {
+        Rectangle r = wall.GetRect();
+        LevelFileRect rect = { r.x, r.y, r.width, r.height, wall.CanStandOnTop() ? 1u : 0u };
+        append(&rect, sizeof(rect));
+    }
+    for (const auto& spawn : level.spawns) {
+        LevelFileSpawn record = { (uint32_t)spawn.kind, spawn.position.x, spawn.position.y };
+        append(&record, sizeof(record));
+    }
+    append(runs.data(), runs.size() * sizeof(TileRun));
+    return SaveFileData(fileName, data.data(), (int)data.size());
+}
+
+EnemyKind GetEnemyKind(const Enemy& enemy)
+{
+    if (dynamic_cast<const Mushroom*>(&enemy) != nullptr) return ENEMY_MUSHROOM;
+    if (dynamic_cast<const Slime*>(&enemy) != nullptr) return ENEMY_SLIME;
+    if (dynamic_cast<const Huntress*>(&enemy) != nullptr) return ENEMY_HUNTRESS;
+    return ENEMY_BOSS;
+}
+
+Enemy* SpawnEnemy(const EnemySpawn& spawn)
+{
+    switch (spawn.kind) {
+        case ENEMY_MUSHROOM: return new Mushroom(spawn.position);
+        case ENEMY_SLIME: return new Slime(spawn.position);
+        case ENEMY_HUNTRESS: return new Huntress(spawn.position);
+        case ENEMY_BOSS: return new Boss(spawn.position);
+        default: return nullptr;
+    }
+}
+
+void SpawnLevelEnemies(const LevelData& level, std::vector<Enemy*>& enemies)
+{
+    LoadTimer timer(LOAD_PHASE, "setup/SpawnLevelEnemies");
+    enemies.reserve(enemies.size() + level.spawns.size());
+    for (const auto& spawn : level.spawns) {
+        Enemy* enemy = SpawnEnemy(spawn);
+        if (enemy != nullptr) enemies.push_back(enemy);
+    }
+}
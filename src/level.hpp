@@ -0,0 +1,58 @@
+#pragma once
+#include <raylib.h>
+#include <string>
+#include <vector>
+#include "platform.hpp"
+#include "tilemap.hpp"
+#include "enemy.hpp"
+
+enum EnemyKind {
+    ENEMY_MUSHROOM,
+    ENEMY_SLIME,
+    ENEMY_HUNTRESS,
+    ENEMY_BOSS,
+    ENEMY_KIND_COUNT
+};
+
+struct EnemySpawn {
+    EnemyKind kind;
+    Vector2 position;
+};
+
+// Everything a level file describes. Music and background are names the game maps to its
+// tracks and background stacks. The tile map is optional and collides alongside the rectangles.
+struct LevelData {
+    float width;
+    float height;
+    std::string music;
+    std::string background;
+    std::vector<Platform> platforms;
+    std::vector<Wall> walls;
+    std::vector<EnemySpawn> spawns;
+    TileMap tiles;
+};
+
+// Text levels (.lvl) are line based, one item per line, '#' starts a comment:
+//
+//   size 1920 1080
+//   music level1
+//   background forest
+//   ground 0 1000 1920 80          x y width height
+//   platform 300 280 1320 40
+//   wall 900 600 48 400 [solid]    'solid' walls cannot be stood on
+//   spawn mushroom 400 120
+//   tilemap 80 45 24               columns rows tile size, clears the grid
+//   tiles 0 41 80 180 ground       col row count, tileset index (-1 = invisible), collision
+//
+// Tile collision is one of empty, platform, ground or solid (see TileCollision).
+// Binary levels (.lvb) hold the same data as fixed-size records, the tiles run-length encoded,
+// and load with no parsing.
+// LoadLevel picks the format from the extension and replaces the level's previous contents.
+bool LoadLevel(const char* fileName, LevelData& level);
+bool ParseLevelText(const char* text, int length, const char* sourceName, LevelData& level);
+bool SaveLevelBinary(const char* fileName, const LevelData& level);
+
+const char* GetEnemyKindName(EnemyKind kind);
+EnemyKind GetEnemyKind(const Enemy& enemy);
+Enemy* SpawnEnemy(const EnemySpawn& spawn);
+void SpawnLevelEnemies(const LevelData& level, std::vector<Enemy*>& enemies);
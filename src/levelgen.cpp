@@ -0,0 +1,180 @@
+#include "levelgen.hpp"
+#include "fighter.hpp"
+#include <cmath>
+#include <cstdint>
+
+static const float GRID = (float)TileMap::TILESET_TILE_SIZE;   // every coordinate snaps to the tile grid
+static const float GROUND_HEIGHT = 80.0f;
+static const float PLATFORM_THICKNESS = 40.0f;
+static const float WALL_WIDTH = 48.0f;
+static const float TOP_MARGIN = 160.0f;
+static const float START_CLEARANCE = 400.0f;    // no walls or enemies this close to the fighter's start
+static const float ENEMY_SPAWN_WIDTH = 100.0f;  // room an enemy needs on its surface
+static const float ASSUMED_FPS = 60.0f;         // Fighter::RUN_SPEED is per frame
+static const float REACH_MARGIN = 0.8f;         // keep jumps comfortably inside the physical limit
+
+// Tileset cells used for generated tile maps (the same ones Platform and Wall draw)
+static const int PLATFORM_TILE = 8 * 21 + 12;
+static const int WALL_TILE = 6 * 21 + 9;
+
+// splitmix64: small, fast and identical on every platform, unlike the std distributions
+struct GenRandom {
+    uint64_t state;
+
+    uint32_t Next()
+    {
+        uint64_t z = (state += 0x9e3779b97f4a7c15ull);
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return (uint32_t)((z ^ (z >> 31)) >> 32);
+    }
+
+    float Range(float min, float max)
+    {
+        return min + (max - min) * (float)(Next() >> 8) / 16777216.0f;
+    }
+
+    int Index(int count)
+    {
+        return (int)(Next() % (uint32_t)count);
+    }
+};
+
+static float Snap(float value)
+{
+    return floorf(value / GRID) * GRID;
+}
+
+// Highest a jump from standing lifts the feet
+static float JumpHeight()
+{
+    return Fighter::JUMP_VELOCITY * Fighter::JUMP_VELOCITY / (2.0f * Fighter::GRAVITY);
+}
+
+// Horizontal distance covered while jumping to a ledge rise pixels higher and landing on it
+static float JumpReach(float rise)
+{
+    float v = -Fighter::JUMP_VELOCITY;
+    float discriminant = v * v - 2.0f * Fighter::GRAVITY * rise;
+    if (discriminant < 0.0f) return 0.0f;
+    float airTime = (v + sqrtf(discriminant)) / Fighter::GRAVITY;
+    return Fighter::RUN_SPEED * ASSUMED_FPS * airTime * REACH_MARGIN;
+}
+
+static bool Reachable(const std::vector<Rectangle>& below, Rectangle target)
+{
+    for (const auto& from : below) {
+        float rise = from.y - target.y;
+        float gap = fmaxf(target.x - (from.x + from.width), from.x - (target.x + target.width));
+        if (gap <= JumpReach(rise)) return true;
+    }
+    return false;
+}
+
+static void AddTileRect(TileMap& tiles, Rectangle rect, int tile, TileCollision top, TileCollision body)
+{
+    int firstCol = (int)(rect.x / GRID);
+    int lastCol = (int)ceilf((rect.x + rect.width) / GRID) - 1;
+    int firstRow = (int)(rect.y / GRID);
+    int lastRow = (int)ceilf((rect.y + rect.height) / GRID) - 1;
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int col = firstCol; col <= lastCol; col++) {
+            tiles.SetTile(col, row, tile, (row == firstRow) ? top : body);
+        }
+    }
+}
+
+void GenerateLevel(const LevelGenSettings& settings, LevelData& level)
+{
+    GenRandom random = { settings.seed * 0x2545f4914f6cdd1dull + 1 };
+    float width = Snap(fmaxf(settings.width, 1920.0f));
+    float height = Snap(fmaxf(settings.height, 1080.0f));
+    float density = fminf(fmaxf(settings.platformDensity, 0.0f), 1.0f);
+    float groundY = Snap(height - GROUND_HEIGHT);
+    float maxRise = Snap(JumpHeight() - 12.0f);
+    float minRise = fmaxf(maxRise - GRID, GRID);
+
+    // Rows of platforms, each row built only from slots reachable from the row below
+    std::vector<Rectangle> surfaces = { {0.0f, groundY, width, height - groundY} };
+    std::vector<Rectangle> below = surfaces;
+    std::vector<Rectangle> row;
+    for (float y = groundY - minRise; y >= TOP_MARGIN; ) {
+        row.clear();
+        for (float x = Snap(random.Range(0.0f, 200.0f)); x < width; ) {
+            float w = fminf(Snap(random.Range(4.0f * GRID, 16.0f * GRID)), width - x);
+            Rectangle candidate = {x, y, w, PLATFORM_THICKNESS};
+            if (w >= 4.0f * GRID && random.Range(0.0f, 1.0f) < density && Reachable(below, candidate)) {
+                row.push_back(candidate);
+            }
+            x += w + Snap(random.Range(2.0f * GRID, 10.0f * GRID));
+        }
+        // Sparse settings still climb: stack one platform over a random one below
+        if (row.empty()) {
+            const Rectangle& base = below[random.Index((int)below.size())];
+            float w = 6.0f * GRID;
+            float x = Snap(fminf(fmaxf(base.x + random.Range(0.0f, fmaxf(base.width - w, 0.0f)), 0.0f), width - w));
+            row.push_back({x, y, w, PLATFORM_THICKNESS});
+        }
+        surfaces.insert(surfaces.end(), row.begin(), row.end());
+        below = row;
+        y -= (random.Index(2) == 0) ? minRise : maxRise;
+    }
+
+    // Walls on the ground, low enough to jump onto
+    std::vector<Rectangle> walls;
+    int wallCount = (int)(width / 1000.0f * density * 2.0f);
+    for (int i = 0; i < wallCount; i++) {
+        float wallHeight = Snap(random.Range(3.0f * GRID, maxRise));
+        float x = Snap(random.Range(START_CLEARANCE, width - WALL_WIDTH));
+        walls.push_back({x, groundY - wallHeight, WALL_WIDTH, wallHeight});
+    }
+
+    level.width = width;
+    level.height = height;
+    level.music = "level2";
+    level.background = "forest";
+    level.platforms.clear();
+    level.walls.clear();
+    level.spawns.clear();
+    level.tiles.Clear();
+    // Grids over TileMap::MAX_CELLS fall back to rectangles
+    if (settings.useTiles && level.tiles.Reset((int)(width / GRID), (int)(height / GRID), (int)GRID)) {
+        AddTileRect(level.tiles, surfaces[0], PLATFORM_TILE, TILE_GROUND, TILE_SOLID);
+        for (size_t i = 1; i < surfaces.size(); i++) {
+            Rectangle platform = surfaces[i];
+            platform.height = GRID;
+            AddTileRect(level.tiles, platform, PLATFORM_TILE, TILE_PLATFORM, TILE_PLATFORM);
+        }
+        for (const auto& wall : walls) {
+            AddTileRect(level.tiles, wall, WALL_TILE, TILE_SOLID, TILE_SOLID);
+        }
+    } else {
+        level.platforms.reserve(surfaces.size());
+        level.platforms.push_back(Platform(surfaces[0].x, surfaces[0].y, surfaces[0].width, surfaces[0].height, true));
+        for (size_t i = 1; i < surfaces.size(); i++) {
+            level.platforms.push_back(Platform(surfaces[i].x, surfaces[i].y, surfaces[i].width, surfaces[i].height));
+        }
+        level.walls.reserve(walls.size());
+        for (const auto& wall : walls) {
+            level.walls.push_back(Wall(wall.x, wall.y, wall.width, wall.height));
+        }
+    }
+
+    // Enemies drop onto random surfaces with room for them past the start clearance; huntresses are rarer
+    static const EnemyKind KINDS[] = { ENEMY_MUSHROOM, ENEMY_MUSHROOM, ENEMY_SLIME, ENEMY_SLIME, ENEMY_HUNTRESS };
+    std::vector<int> spawnSurfaces;
+    for (int i = 0; i < (int)surfaces.size(); i++) {
+        if (surfaces[i].x + surfaces[i].width - ENEMY_SPAWN_WIDTH >= fmaxf(surfaces[i].x, START_CLEARANCE)) spawnSurfaces.push_back(i);
+    }
+    int enemyCount = spawnSurfaces.empty() ? 0 : (int)(width / 1000.0f * fmaxf(settings.enemyDensity, 0.0f) + 0.5f);
+    level.spawns.reserve(enemyCount);
+    for (int i = 0; i < enemyCount; i++) {
+        const Rectangle& surface = surfaces[spawnSurfaces[random.Index((int)spawnSurfaces.size())]];
+        float x = random.Range(fmaxf(surface.x, START_CLEARANCE), surface.x + surface.width - ENEMY_SPAWN_WIDTH);
+        EnemyKind kind = KINDS[random.Index((int)(sizeof(KINDS) / sizeof(KINDS[0])))];
+        level.spawns.push_back(EnemySpawn{kind, {x, surface.y - 150.0f}});
+    }
+
+    TraceLog(LOG_INFO, "LEVELGEN: seed %u: %.0fx%.0f, %i platforms, %i walls, %i enemies%s", settings.seed, width, height,
+             (int)surfaces.size(), (int)walls.size(), enemyCount, level.tiles.IsEmpty() ? "" : " (tile map)");
+}
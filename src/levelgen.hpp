@@ -0,0 +1,19 @@
+#pragma once
+#include "level.hpp"
+
+// Seeded procedural levels for scaling tests. The same settings always give the same level.
+//
+// Platforms are laid out in rows above a full-width ground. Every platform is placed within a
+// jump of one in the row below, using the Fighter's gravity, jump velocity and run speed, so the
+// whole layout can be reached from the ground. Walls stand on the ground and are low enough to
+// jump onto. Enemies (mushrooms, slimes, huntresses) are dropped onto random platforms.
+struct LevelGenSettings {
+    unsigned int seed;
+    float width;            // world size in pixels; height is at least 1080
+    float height;
+    float platformDensity;  // 0..1, share of candidate platform slots that are kept
+    float enemyDensity;     // enemies per 1000 pixels of level width
+    bool useTiles;          // emit the geometry as a tile map instead of Platform/Wall rectangles
+};
+
+void GenerateLevel(const LevelGenSettings& settings, LevelData& level);
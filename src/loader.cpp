@@ -0,0 +1,291 @@
+#include "loader.hpp"
+#include "render.hpp"
+#include "vfs.hpp"
+#include "loadtimes.hpp"
+#include "trace.hpp"
+#include "external/dr_mp3.h"    // bundled and compiled into raylib
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+enum AssetJobType { JOB_IMAGE, JOB_FONT, JOB_AUDIO_PROBE };
+
+struct AssetJob {
+    AssetJobType type;
+    std::string fileName;
+    int fontSize;
+    std::atomic<bool> done{false};
+    bool taken;                 // cancelled while a worker decodes it; that worker deletes it (guarded by queueMutex)
+
+    Image image;                // JOB_IMAGE, or the glyph atlas for JOB_FONT
+    GlyphInfo* glyphs;          // JOB_FONT
+    Rectangle* recs;
+    int glyphCount;
+};
+
+// Jobs nobody has claimed or cancelled yet, by type, font size and path. A job leaves this map
+// once claimed or cancelled and is deleted as soon as no worker is using it.
+static std::unordered_map<std::string, AssetJob*> pending;
+static std::deque<AssetJob*> queue;     // jobs waiting for a worker
+static std::vector<std::thread> workers;
+static std::mutex queueMutex;
+static std::condition_variable queueReady;
+static std::condition_variable jobFinished;
+static bool stopping = false;
+static int queuedCount = 0;             // every job queued since the loader started (guarded by queueMutex)
+static std::atomic<int> finishedCount{0};
+
+static const int FONT_GLYPH_COUNT = 95;     // same ASCII range raylib loads by default
+static const int FONT_GLYPH_PADDING = 4;
+
+static long long ImageBytes(Image image)
+{
+    return (image.data != NULL) ? GetPixelDataSize(image.width, image.height, image.format) : 0;
+}
+
+static void RunJob(AssetJob& job)
+{
+    LoadTimer timer(LOAD_DECODE, job.fileName.c_str());
+    if (job.type == JOB_IMAGE) {
+        job.image = LoadImage(job.fileName.c_str());
+        timer.SetBytes(ImageBytes(job.image));
+    }
+    else if (job.type == JOB_FONT) {
+        // Everything LoadFontEx does except the texture upload
+        int dataSize = 0;
+        unsigned char* data = LoadFileData(job.fileName.c_str(), &dataSize);
+        if (data != NULL) {
+            job.glyphCount = FONT_GLYPH_COUNT;
+            job.glyphs = LoadFontData(data, dataSize, job.fontSize, NULL, FONT_GLYPH_COUNT, FONT_DEFAULT);
+            UnloadFileData(data);
+            if (job.glyphs != NULL) {
+                job.image = GenImageFontAtlas(job.glyphs, &job.recs, job.glyphCount, job.fontSize, FONT_GLYPH_PADDING, 0);
+                timer.SetBytes(ImageBytes(job.image));
+            }
+        }
+    }
+    else if (job.type == JOB_AUDIO_PROBE) {
+        drmp3* decoder = new drmp3;
+        size_t packedSize = 0;
+        const unsigned char* packed = GetPackedAsset(job.fileName.c_str(), &packedSize);
+        bool opened = (packed != nullptr) ? drmp3_init_memory(decoder, packed, packedSize, NULL)
+                                          : drmp3_init_file(decoder, job.fileName.c_str(), NULL);
+        if (opened) {
+            TraceLog(LOG_DEBUG, "LOADER: %s (%u Hz, %u ch)", job.fileName.c_str(), decoder->sampleRate, decoder->channels);
+            drmp3_uninit(decoder);
+        } else {
+            TraceLog(LOG_WARNING, "LOADER: Could not open audio '%s'", job.fileName.c_str());
+        }
+        delete decoder;
+    }
+}
+
+static void WorkerLoop()
+{
+    TraceSetThreadName("asset loader");
+    for (;;) {
+        AssetJob* job = nullptr;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [] { return stopping || !queue.empty(); });
+            if (queue.empty()) return;
+            job = queue.front();
+            queue.pop_front();
+        }
+        RunJob(*job);
+        {
+            std::lock_guard<std::mutex> lock(queueMutex);
+            if (job->taken) {
+                // Cancelled while decoding
+                if (job->image.data != NULL) UnloadImage(job->image);
+                delete job;
+            } else {
+                job->done.store(true, std::memory_order_release);
+            }
+            finishedCount++;
+        }
+        jobFinished.notify_all();
+    }
+}
+
+void StartAssetLoader(int workerCount)
+{
+    if (workerCount < 1) workerCount = 1;
+    stopping = false;
+    for (int i = 0; i < workerCount; i++) {
+        workers.emplace_back(WorkerLoop);
+    }
+}
+
+static std::string JobKey(AssetJobType type, const char* fileName, int fontSize)
+{
+    return std::to_string((int)type) + ':' + std::to_string(fontSize) + ':' + fileName;
+}
+
+// Unclaimed job for the path, finished or not; caller holds queueMutex
+static AssetJob* FindPendingJob(const std::string& key)
+{
+    auto it = pending.find(key);
+    return (it != pending.end()) ? it->second : nullptr;
+}
+
+// Frees whatever a finished or never-started job still holds
+static void DeleteJob(AssetJob* job)
+{
+    if (job->image.data != NULL) UnloadImage(job->image);
+    if (job->glyphs != NULL) UnloadFontData(job->glyphs, job->glyphCount);
+    if (job->recs != NULL) MemFree(job->recs);
+    delete job;
+}
+
+static void Queue(AssetJobType type, const char* fileName, int fontSize)
+{
+    AssetJob* job;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        std::string key = JobKey(type, fileName, fontSize);
+        if (FindPendingJob(key) != nullptr) return;
+        job = new AssetJob;
+        job->type = type;
+        job->fileName = fileName;
+        job->fontSize = fontSize;
+        job->taken = false;
+        job->image = Image{0};
+        job->glyphs = NULL;
+        job->recs = NULL;
+        job->glyphCount = 0;
+        pending.emplace(key, job);
+        queue.push_back(job);
+        queuedCount++;
+    }
+    queueReady.notify_one();
+}
+
+void QueueImageLoad(const char* fileName) { Queue(JOB_IMAGE, fileName, 0); }
+void QueueFontLoad(const char* fileName, int fontSize) { Queue(JOB_FONT, fileName, fontSize); }
+void QueueAudioProbe(const char* fileName) { Queue(JOB_AUDIO_PROBE, fileName, 0); }
+
+void CancelImageLoad(const char* fileName)
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    auto found = pending.find(JobKey(JOB_IMAGE, fileName, 0));
+    if (found == pending.end()) return;
+    AssetJob* job = found->second;
+    pending.erase(found);
+
+    for (auto it = queue.begin(); it != queue.end(); ++it) {
+        if (*it != job) continue;
+        // Never started: retire it here so the finished count still adds up
+        queue.erase(it);
+        DeleteJob(job);
+        finishedCount++;
+        return;
+    }
+    if (job->done.load(std::memory_order_acquire)) {
+        DeleteJob(job);
+    } else {
+        job->taken = true;  // a worker is decoding it and deletes it when it finishes
+    }
+}
+
+int GetQueuedAssetCount()
+{
+    std::lock_guard<std::mutex> lock(queueMutex);
+    return queuedCount;
+}
+
+int GetFinishedAssetCount()
+{
+    return finishedCount.load();
+}
+
+bool AssetLoadsFinished()
+{
+    return GetFinishedAssetCount() >= GetQueuedAssetCount();
+}
+
+// Waits for the unclaimed job for the path to finish and hands it to the caller; null if it was never queued
+static std::unique_ptr<AssetJob> ClaimJob(AssetJobType type, const char* fileName, int fontSize)
+{
+    std::unique_lock<std::mutex> lock(queueMutex);
+    std::string key = JobKey(type, fileName, fontSize);
+    AssetJob* job = FindPendingJob(key);
+    if (job == nullptr) return nullptr;
+    jobFinished.wait(lock, [job] { return job->done.load(std::memory_order_acquire); });
+    pending.erase(key);
+    return std::unique_ptr<AssetJob>(job);
+}
+
+Image LoadImagePreloaded(const char* fileName)
+{
+    std::unique_ptr<AssetJob> job = ClaimJob(JOB_IMAGE, fileName, 0);
+    if (job == nullptr) {
+        LoadTimer timer(LOAD_DECODE, fileName);
+        Image image = LoadImage(fileName);
+        timer.SetBytes(ImageBytes(image));
+        return image;
+    }
+    return job->image;
+}
+
+Texture2D LoadTexturePreloaded(const char* fileName)
+{
+    Image image = LoadImagePreloaded(fileName);
+    LoadTimer timer(LOAD_UPLOAD, fileName);
+    Texture2D texture = GetRenderBackend().LoadTextureFromImage(image);
+    timer.SetBytes(ImageBytes(image));
+    UnloadImage(image);
+    return texture;
+}
+
+Font LoadFontPreloaded(const char* fileName, int fontSize)
+{
+    std::unique_ptr<AssetJob> job = ClaimJob(JOB_FONT, fileName, fontSize);
+    if (job == nullptr || job->glyphs == NULL) {
+        LoadTimer timer(LOAD_DECODE, fileName);     // decode and upload together
+        return GetRenderBackend().LoadFontEx(fileName, fontSize, NULL, 0);
+    }
+
+    Font font = {0};
+    font.baseSize = fontSize;
+    font.glyphCount = job->glyphCount;
+    font.glyphPadding = FONT_GLYPH_PADDING;
+    font.glyphs = job->glyphs;
+    font.recs = job->recs;
+    {
+        LoadTimer timer(LOAD_UPLOAD, fileName);
+        font.texture = GetRenderBackend().LoadTextureFromImage(job->image);
+        timer.SetBytes(ImageBytes(job->image));
+    }
+    UnloadImage(job->image);
+    return font;
+}
+
+void StopAssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        stopping = true;
+        queue.clear();
+    }
+    queueReady.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+    workers.clear();
+
+    // Free results nobody asked for; jobs cancelled mid-decode were deleted by their workers
+    for (auto& entry : pending) {
+        DeleteJob(entry.second);
+    }
+    pending.clear();
+    queuedCount = 0;
+    finishedCount = 0;
+}
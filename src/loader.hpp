@@ -0,0 +1,22 @@
+#pragma once
+#include <raylib.h>
+
+// Decodes assets on worker threads ahead of use. Anything that later loads the same path picks up
+// the decoded data instead of reading the disk; GPU uploads still happen on the calling (main)
+// thread. Paths that were never queued fall back to a normal synchronous load.
+void StartAssetLoader(int workerCount);
+void StopAssetLoader();                 // joins the workers and frees anything never picked up
+
+void QueueImageLoad(const char* fileName);   // no-op while the same image is already queued or unclaimed
+void CancelImageLoad(const char* fileName);  // drops a queued or unclaimed image nobody will use
+void QueueFontLoad(const char* fileName, int fontSize);
+void QueueAudioProbe(const char* fileName);     // opens the stream header to validate the file
+
+int GetQueuedAssetCount();
+int GetFinishedAssetCount();
+bool AssetLoadsFinished();
+
+// Hand over queued work; these wait if the asset is still being decoded
+Image LoadImagePreloaded(const char* fileName);
+Texture2D LoadTexturePreloaded(const char* fileName);
+Font LoadFontPreloaded(const char* fileName, int fontSize);
@@ -0,0 +1,163 @@
+#include "loadtimes.hpp"
+#include "trace.hpp"
+#include <raylib.h>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+struct AssetRecord {
+    std::string fileName;
+    double decodeMs;
+    double uploadMs;
+    long long bytes;
+    long long gpuBytes;
+};
+
+struct PhaseRecord {
+    std::string name;
+    int count;
+    double totalMs;
+    double maxMs;
+};
+
+struct LoadBudget {
+    std::string prefix;
+    double budgetMs;
+};
+
+static std::mutex recordMutex;
+static std::vector<AssetRecord> assets;
+static std::vector<PhaseRecord> phases;
+static std::vector<LoadBudget> budgets;
+
+static AssetRecord& FindAsset(const char* fileName)
+{
+    for (auto& asset : assets) {
+        if (asset.fileName == fileName) return asset;
+    }
+    assets.push_back(AssetRecord{fileName, 0.0, 0.0, 0, 0});
+    return assets.back();
+}
+
+static PhaseRecord& FindPhase(const char* name)
+{
+    for (auto& phase : phases) {
+        if (phase.name == name) return phase;
+    }
+    phases.push_back(PhaseRecord{name, 0, 0.0, 0.0});
+    return phases.back();
+}
+
+LoadTimer::LoadTimer(LoadStage stage, const char* name)
+{
+    this->stage = stage;
+    this->name = name;
+    bytes = 0;
+    start = std::chrono::steady_clock::now();
+}
+
+LoadTimer::~LoadTimer()
+{
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    TraceRecord(name, start, end);
+    double ms = std::chrono::duration<double, std::milli>(end - start).count();
+    if (stage == LOAD_PHASE) {
+        RecordLoadPhase(name, ms);
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(recordMutex);
+    AssetRecord& asset = FindAsset(name);
+    if (stage == LOAD_DECODE) {
+        asset.decodeMs += ms;
+        asset.bytes += bytes;
+    } else {
+        asset.uploadMs += ms;
+        asset.gpuBytes += bytes;
+    }
+}
+
+void LoadTimer::SetBytes(long long bytes)
+{
+    this->bytes = bytes;
+}
+
+void RecordLoadPhase(const char* name, double ms)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    PhaseRecord& phase = FindPhase(name);
+    phase.count++;
+    phase.totalMs += ms;
+    if (ms > phase.maxMs) phase.maxMs = ms;
+}
+
+void SetLoadBudget(const char* prefix, double budgetMs)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+    budgets.push_back(LoadBudget{prefix, budgetMs});
+}
+
+static const LoadBudget* FindBudget(const std::string& phaseName)
+{
+    for (const auto& budget : budgets) {
+        if (phaseName.compare(0, budget.prefix.size(), budget.prefix) == 0) return &budget;
+    }
+    return nullptr;
+}
+
+static void WriteJsonString(FILE* file, const std::string& text)
+{
+    fputc('"', file);
+    for (char c : text) {
+        if (c == '"' || c == '\\') fputc('\\', file);
+        fputc(c, file);
+    }
+    fputc('"', file);
+}
+
+bool WriteLoadReport(const char* fileName)
+{
+    std::lock_guard<std::mutex> lock(recordMutex);
+
+    bool withinBudget = true;
+    for (const auto& phase : phases) {
+        const LoadBudget* budget = FindBudget(phase.name);
+        if (budget != nullptr && phase.maxMs > budget->budgetMs) {
+            TraceLog(LOG_WARNING, "LOADTIME: %s took %.1f ms, over its %.1f ms budget", phase.name.c_str(), phase.maxMs, budget->budgetMs);
+            withinBudget = false;
+        }
+    }
+
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "LOADTIME: Could not write report '%s'", fileName);
+        return withinBudget;
+    }
+
+    fprintf(file, "{\n  \"withinBudget\": %s,\n  \"phases\": [", withinBudget ? "true" : "false");
+    for (size_t i = 0; i < phases.size(); i++) {
+        const PhaseRecord& phase = phases[i];
+        const LoadBudget* budget = FindBudget(phase.name);
+        fprintf(file, "%s\n    {\"name\": ", (i == 0) ? "" : ",");
+        WriteJsonString(file, phase.name);
+        fprintf(file, ", \"count\": %d, \"totalMs\": %.3f, \"maxMs\": %.3f", phase.count, phase.totalMs, phase.maxMs);
+        if (budget != nullptr) {
+            fprintf(file, ", \"budgetMs\": %.3f, \"exceeded\": %s", budget->budgetMs, (phase.maxMs > budget->budgetMs) ? "true" : "false");
+        }
+        fputc('}', file);
+    }
+    fprintf(file, "\n  ],\n  \"assets\": [");
+    for (size_t i = 0; i < assets.size(); i++) {
+        const AssetRecord& asset = assets[i];
+        fprintf(file, "%s\n    {\"file\": ", (i == 0) ? "" : ",");
+        WriteJsonString(file, asset.fileName);
+        fprintf(file, ", \"decodeMs\": %.3f, \"uploadMs\": %.3f, \"bytes\": %lld, \"gpuBytes\": %lld}",
+                asset.decodeMs, asset.uploadMs, asset.bytes, asset.gpuBytes);
+    }
+    fprintf(file, "\n  ]\n}\n");
+    fclose(file);
+
+    TraceLog(LOG_INFO, "LOADTIME: Wrote %s (%i phases, %i assets)", fileName, (int)phases.size(), (int)assets.size());
+    return withinBudget;
+}
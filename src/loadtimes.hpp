@@ -0,0 +1,32 @@
+#pragma once
+#include <chrono>
+
+// Where load time goes. Asset records split each file into decode (file read + image decode, often
+// on a loader thread) and upload (GPU) time; phase records aggregate named scopes such as
+// constructors and level setup. Recording is thread-safe. The report is written as JSON on exit.
+enum LoadStage {
+    LOAD_DECODE,
+    LOAD_UPLOAD,
+    LOAD_PHASE
+};
+
+class LoadTimer {
+public:
+    LoadTimer(LoadStage stage, const char* name);
+    ~LoadTimer();
+    void SetBytes(long long bytes);     // decoded bytes for LOAD_DECODE, GPU bytes for LOAD_UPLOAD
+
+private:
+    LoadStage stage;
+    const char* name;
+    long long bytes;
+    std::chrono::steady_clock::time_point start;
+};
+
+void RecordLoadPhase(const char* name, double ms);
+
+// Phases whose name starts with prefix are over budget when any single run exceeds budgetMs
+void SetLoadBudget(const char* prefix, double budgetMs);
+
+// Writes the report; returns false if any budget was exceeded (the report is written either way)
+bool WriteLoadReport(const char* fileName);
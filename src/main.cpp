@@ -1,16 +1,38 @@
 #include <raylib.h>
 #include <math.h>
+#include <algorithm>
 #include <vector>
-#include <string>
 #include <cctype>
+#include <chrono>
+#include <thread>
 #include "fighter.hpp"
 #include "platform.hpp"
+#include "spatialgrid.hpp"
 #include "animation.h"
 #include "enemy.hpp"
 #include "mushroom.hpp"
 #include "slime.hpp"
 #include "huntress.hpp"
 #include "bringerofdeath.hpp"
+#include "background.hpp"
+#include "camera.hpp"
+#include "world.hpp"
+#include "hud.hpp"
+#include "config.hpp"
+#include "pacing.hpp"
+#include "particles.hpp"
+#include "render.hpp"
+#include "music.hpp"
+#include "sfx.hpp"
+#include "loader.hpp"
+#include "residency.hpp"
+#include "vfs.hpp"
+#include "loadtimes.hpp"
+#include "level.hpp"
+#include "levelgen.hpp"
+#include "streaming.hpp"
+#include "perfoverlay.hpp"
+#include "trace.hpp"
 
 enum class GameState {
     Start,
@@ -18,75 +40,229 @@ enum class GameState {
     Level2,
     Level3,
     BossLevel,
+    Generated,      // procedural level from LevelGenSettings, won by clearing it
     Pause,
     GameWon,
     GameOver
 };
 
+// Tracks the MusicManager crossfades between, one per game state
+enum MusicTrack {
+    MUSIC_MENU,
+    MUSIC_LEVEL1,
+    MUSIC_LEVEL2,
+    MUSIC_LEVEL3,
+    MUSIC_BOSS,
+    MUSIC_GAME_OVER,
+    MUSIC_GAME_WON
+};
+
+// Names level files use for the tracks above
+static const char* MUSIC_NAMES[] = { "menu", "level1", "level2", "level3", "boss", "game-over", "game-won" };
+
+static const char* MUSIC_FILES[] = {
+    "resources/music/Xasthur - Exit HD.mp3",
+    "resources/music/Fallen Down.mp3",
+    "resources/music/Rush E.mp3",
+    "resources/music/hkmori - anybody can find love (except you.).mp3",
+    "resources/music/MEGALOVANIA - Toby Fox.mp3",
+    "resources/music/SUPER MARIO - game over - sound effect.mp3",
+    "resources/music/Drum Roll (Ending Celebration) - Sound Effect  ProSounds.mp3"
+};
+
+// Images decoded by the loader during startup for the fighter, who stays resident all session;
+// everything else is decoded through the asset sets below
+static const char* STARTUP_IMAGES[] = {
+    "resources/char_red_1.png",
+    "resources/char_red_2.png"
+};
+
+static const TextureAsset FOREST_BACK = {"resources/background/background_layer_1.png", 0, 0};
+static const TextureAsset FOREST_MID = {"resources/background/background_layer_2.png", 0, 0};
+static const TextureAsset FOREST_FRONT = {"resources/background/background_layer_3.png", 0, 0};
+static const TextureAsset CAVE_BACKGROUND = {"resources/background/awesomeCavePixelArt.png", 0, 0};
+static const TextureAsset GAME_LOGO = {"resources/logo1a.png", 0, 0};
+static const TextureAsset TILESET = {"resources/oak_woods_tileset.png", 0, 0};
+
+// Textures resident per game state; Pause, GameOver and GameWon keep the set of the level they follow
+enum AssetSetId {
+    SET_MENU,
+    SET_LEVEL1,
+    SET_LEVEL2,
+    SET_LEVEL3,
+    SET_BOSS,
+    SET_GENERATED
+};
+
+static const char* HUD_FONT = "resources/fonts/Chewy-Regular.ttf";
+
+// Sound effects decoded when each level loads
+static const SfxId LEVEL_SFX[] = { SFX_SLASH, SFX_HIT, SFX_ENEMY_DEATH, SFX_PLAYER_DEATH };
+static const SfxId HUNTRESS_LEVEL_SFX[] = { SFX_SLASH, SFX_HIT, SFX_ENEMY_DEATH, SFX_PLAYER_DEATH, SFX_SPEAR_THROW, SFX_SPEAR_IMPACT };
+static const SfxId BOSS_LEVEL_SFX[] = { SFX_SLASH, SFX_HIT, SFX_ENEMY_DEATH, SFX_PLAYER_DEATH, SFX_BOSS_CAST };
+
+// Background stacks composited once each by BackgroundCompositor
+enum BackgroundStack {
+    BG_MENU,
+    BG_FOREST,
+    BG_CAVE
+};
+
+static const char* BACKGROUND_NAMES[] = { "menu", "forest", "cave" };
+
+static const char* LEVEL_FILES[] = {
+    "resources/levels/level1.lvl",
+    "resources/levels/level2.lvl",
+    "resources/levels/level3.lvl",
+    "resources/levels/boss.lvl"
+};
+
+// Maps a level file's name for a track or background to its index; fallback if unknown
+static int FindNamed(const char* const* names, int count, const std::string& name, int fallback)
+{
+    for (int i = 0; i < count; i++) {
+        if (name == names[i]) return i;
+    }
+    return fallback;
+}
+
 // function declarations for level management
 void ClearEnemies(std::vector<Enemy*>& enemies);
-void SpawnLevel1Enemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight);
-void SpawnLevel2Enemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight);
-void SpawnLevel3Enemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight);
-void SpawnBossLevelEnemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight);
-void CreateLevel1Platforms(std::vector<Platform>& platforms, int screenWidth, int screenHeight, int groundHeight);
-void CreateLevel2Platforms(std::vector<Platform>& platforms, int screenWidth, int screenHeight, int groundHeight);
-void CreateLevel3Platforms(std::vector<Platform>& platforms, std::vector<Wall>& walls, int screenWidth, int screenHeight, int groundHeight);
-void CreateBossLevelPlatforms(std::vector<Platform>& platforms, std::vector<Wall>& walls, int screenWidth, int screenHeight, int groundHeight);
+void BuildEnemyGrid(SpatialGrid& grid, const std::vector<Enemy*>& enemies);
+void PresentFrame(RenderTexture2D frameTarget);
+void DrawLoadingScreen(float progress, float time);
 
 
-int main() 
+int main(int argc, char** argv) 
 {
-    SetConfigFlags(FLAG_FULLSCREEN_MODE | FLAG_WINDOW_TOPMOST);
-    InitWindow(1920, 1080, "Game");
+    auto processStart = std::chrono::steady_clock::now();
+    auto millisecondsSinceStart = [processStart]() {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - processStart).count();
+    };
+    double firstFrameMs = -1.0;
+    double interactiveMs = -1.0;
+
+    GameConfig config = LoadGameConfig(argc, argv);
+    MountAssetPack(config.assetPack.c_str());
+
+    // --convert-level=resources/levels/level1.lvl writes resources/levels/level1.lvb and exits
+    if (!config.convertLevel.empty()) {
+        LevelData source;
+        std::string output = std::string(GetDirectoryPath(config.convertLevel.c_str())) + "/" +
+                             GetFileNameWithoutExt(config.convertLevel.c_str()) + ".lvb";
+        bool converted = LoadLevel(config.convertLevel.c_str(), source) && SaveLevelBinary(output.c_str(), source);
+        TraceLog(converted ? LOG_INFO : LOG_WARNING, "LEVEL: %s %s", converted ? "Wrote" : "Could not convert to", output.c_str());
+        UnmountAssetPack();
+        return converted ? 0 : 1;
+    }
+    if (config.startupBudgetMs > 0.0f) SetLoadBudget("startup/interactive", config.startupBudgetMs);
+    if (config.levelBudgetMs > 0.0f) SetLoadBudget("level/", config.levelBudgetMs);
+    TraceSetThreadName("main");
+
+    // Headless runs submit to the null backend and never open a window: the game starts itself,
+    // runs a fixed number of frames with a fixed time step and reports what it would have drawn
+    bool headless = (config.headlessFrames > 0);
+    NullRenderBackend nullBackend;
+    if (headless) {
+        SetRenderBackend(&nullBackend);
+        config.pacing = PacingMode::Uncapped;
+    }
+    RenderBackend& gfx = GetRenderBackend();
 
-    HideCursor();
+    if (!headless) {
+        SetConfigFlags(FLAG_FULLSCREEN_MODE | FLAG_WINDOW_TOPMOST | GetPacingWindowFlags(config.pacing));
+        InitWindow(1920, 1080, "Game");
 
-    // Get Monitor Dimensions
-    int monitor = GetCurrentMonitor();
-    int screenWidth = GetMonitorWidth(monitor);
-    int screenHeight = GetMonitorHeight(monitor);
+        HideCursor();
 
-    const Vector2 screenSize = { (float)screenWidth, (float)screenHeight };
-    
-    SetWindowSize(screenWidth, screenHeight);
+        // Get Monitor Dimensions
+        int monitor = GetCurrentMonitor();
+        int windowWidth = GetMonitorWidth(monitor);
+        int windowHeight = GetMonitorHeight(monitor);
+        SetWindowSize(windowWidth, windowHeight);
+    }
+
+    // Layout resolution: levels, spawns and UI are authored for 1920x1080
+    const int screenWidth = 1920;
+    const int screenHeight = 1080;
+    SetViewSize(screenWidth, screenHeight);
+    SetWorldSize((float)screenWidth, (float)screenHeight); // current levels span exactly one screen
+
+    // The frame is rendered at a fixed internal resolution and upscaled to the window
+    RenderTexture2D frameTarget = gfx.LoadRenderTexture(config.renderWidth, config.renderHeight);
+    gfx.SetTextureFilter(frameTarget.texture, TEXTURE_FILTER_POINT);
+    float renderScale = (float)config.renderWidth / (float)screenWidth;
+    Camera2D uiCamera = { {0, 0}, {0, 0}, 0.0f, renderScale };
+
+    InitParticles(config.particleBudget);
+    SetPerfOverlayVisible(config.perfOverlay);
     
-    SetTargetFPS(60);
+    FramePacer pacer;
+    pacer.Init(config.pacing, config.targetFps);
     InitAudioDevice();
+    InitSfx(24);
 
     float HUDfontSize = 64.0f;
-    Font fnt_chewy = LoadFontEx("resources/fonts/Chewy-Regular.ttf", HUDfontSize, 0, 0);
+
+    // Decode startup assets on worker threads while a loading screen animates; only the GPU
+    // uploads below run on this thread
+    int loaderThreads = (int)std::thread::hardware_concurrency() - 1;
+    StartAssetLoader(loaderThreads < 1 ? 1 : (loaderThreads > 4 ? 4 : loaderThreads));
+    QueueFontLoad(HUD_FONT, (int)HUDfontSize);
+    for (const char* image : STARTUP_IMAGES) {
+        QueueImageLoad(image);
+    }
+    DefineAssetSet(SET_MENU, "menu", { FOREST_BACK, GAME_LOGO });
+    DefineAssetSet(SET_LEVEL1, "level1", { FOREST_BACK, FOREST_MID, FOREST_FRONT, TILESET, Mushroom::SHEET, Slime::SHEET });
+    DefineAssetSet(SET_LEVEL2, "level2", { FOREST_BACK, FOREST_MID, FOREST_FRONT, TILESET, Mushroom::SHEET, Slime::SHEET });
+    DefineAssetSet(SET_LEVEL3, "level3", { FOREST_BACK, FOREST_MID, FOREST_FRONT, TILESET, Huntress::SHEET, Huntress::SPEAR_SHEET });
+    DefineAssetSet(SET_BOSS, "boss", { CAVE_BACKGROUND, TILESET, Boss::SHEET });
+    DefineAssetSet(SET_GENERATED, "generated", { FOREST_BACK, FOREST_MID, FOREST_FRONT, TILESET, Mushroom::SHEET, Slime::SHEET,
+                                                 Huntress::SHEET, Huntress::SPEAR_SHEET });
+    PrefetchAssetSet(SET_MENU);
+    for (const char* track : MUSIC_FILES) {
+        QueueAudioProbe(track);
+    }
+    {
+        LoadTimer preloadTimer(LOAD_PHASE, "startup/preload");
+        while (!AssetLoadsFinished() && (headless || !WindowShouldClose())) {
+            gfx.BeginDrawing();
+            gfx.ClearBackground(BLACK);
+            DrawLoadingScreen((float)GetFinishedAssetCount() / (float)GetQueuedAssetCount(), (float)GetGameTime());
+            gfx.EndDrawing();
+            if (firstFrameMs < 0.0) firstFrameMs = millisecondsSinceStart();
+        }
+    }
+
+    Font fnt_chewy = LoadFontPreloaded(HUD_FONT, (int)HUDfontSize);
+    Hud hud;
+    hud.Init(fnt_chewy, HUDfontSize, 3.0f);
     
-    Texture2D background = LoadTexture("resources/background/background_layer_1.png");
-    Texture2D midground = LoadTexture("resources/background/background_layer_2.png");
-    Texture2D foreground = LoadTexture("resources/background/background_layer_3.png");
-    Texture2D bossBG = LoadTexture("resources/background/awesomeCavePixelArt.png");
-    Texture2D gameLogo = LoadTexture("resources/logo1a.png");
-    Texture2D tileset = LoadTexture("resources/oak_woods_tileset.png");
+    // The first level decodes in the background while the menu is up
+    ActivateAssetSet(SET_MENU);
+    PrefetchAssetSet(SET_LEVEL1);
+
+    BackgroundCompositor backgrounds;
+    backgrounds.AddStack(BG_MENU, { {FOREST_BACK.fileName, true, 0.0f} });
+    backgrounds.AddStack(BG_FOREST, { {FOREST_BACK.fileName, true, 0.0f}, {FOREST_MID.fileName, false, 0.0f}, {FOREST_FRONT.fileName, false, 0.0f} });
+    backgrounds.AddStack(BG_CAVE, { {CAVE_BACKGROUND.fileName, true, 0.0f} });
     
     float masterVolume = 1.0f;
 
-    Music menuMusic = LoadMusicStream("resources/music/Xasthur - Exit HD.mp3");
-    Music level1Music = LoadMusicStream("resources/music/Fallen Down.mp3");
-    Music level2Music = LoadMusicStream("resources/music/Rush E.mp3");
-    Music level3Music = LoadMusicStream("resources/music/hkmori - anybody can find love (except you.).mp3");
-    Music bossLevelMusic = LoadMusicStream("resources/music/MEGALOVANIA - Toby Fox.mp3");
-    Music gameOverMusic = LoadMusicStream("resources/music/SUPER MARIO - game over - sound effect.mp3");
-    Music gameWonMusic = LoadMusicStream("resources/music/Drum Roll (Ending Celebration) - Sound Effect  ProSounds.mp3");
-    SetMusicVolume(menuMusic, 0.6f);
-    SetMusicVolume(level1Music, 0.6f);
-    SetMusicVolume(level2Music, 0.6f);
-    SetMusicVolume(level3Music, 0.6f);
-    SetMusicVolume(bossLevelMusic, 0.6f);
-    SetMusicVolume(gameOverMusic, 0.6f);
-    SetMusicVolume(gameWonMusic, 0.6f);
+    // Tracks are opened on demand and decoded on the music thread
+    MusicManager music;
+    music.Init(1.5f);
+    for (int track = MUSIC_MENU; track <= MUSIC_GAME_WON; track++) {
+        music.AddTrack(track, MUSIC_FILES[track], 0.6f);
+    }
     SetMasterVolume(masterVolume);
 
     Fighter fighter;
     
     std::vector<Enemy*> enemies;
-
-    Mushroom::LoadSharedTexture();
+    // Live enemies by position, rebuilt once per frame for the world pass to cull against
+    SpatialGrid enemyGrid;
+    std::vector<int> visibleEnemies;
 
     GameState gameState = GameState::Start;
     GameState prevState = GameState::Level1;
@@ -120,24 +296,77 @@ int main()
     int wallHeight = 120;
     int wallRow = 9;
     int wallCol = 6;
-    int groundHeight = 80;
 
-    std::vector<Platform> platforms;
-    std::vector<Wall> walls;
+    LevelData level;
+    std::vector<Platform>& platforms = level.platforms;
+    std::vector<Wall>& walls = level.walls;
+    MusicTrack levelMusic = MUSIC_LEVEL1;
+    BackgroundStack levelBackground = BG_FOREST;
+    LevelStreamer streamer;
+    // Spawns the enemies of the level just loaded or generated and sizes the world to it. Long
+    // levels are handed to the streamer, which spawns enemies as their chunks come into range.
+    auto beginLevel = [&]() {
+        streamer.End();
+        if (config.streamLevels && level.width >= 4.0f * config.streamChunkWidth) {
+            streamer.Begin(level, config.streamCache.c_str(), config.streamChunkWidth);
+        }
+        SpawnLevelEnemies(level, enemies);
+        SetActiveTileMap(&level.tiles);
+        SetWorldSize(level.width > 0.0f ? level.width : (float)screenWidth, level.height > 0.0f ? level.height : (float)screenHeight);
+        levelMusic = (MusicTrack)FindNamed(MUSIC_NAMES, MUSIC_GAME_WON + 1, level.music, MUSIC_LEVEL1);
+        levelBackground = (BackgroundStack)FindNamed(BACKGROUND_NAMES, BG_CAVE + 1, level.background, BG_FOREST);
+    };
+    auto enterLevel = [&](int index) {
+        if (!LoadLevel(LEVEL_FILES[index], level)) {
+            TraceLog(LOG_ERROR, "LEVEL: Could not load %s", LEVEL_FILES[index]);
+        }
+        beginLevel();
+    };
+    // Each generated run from the menu uses the next seed, so a session can be replayed from its log
+    LevelGenSettings levelGen = { config.genSeed, config.genWidth, config.genHeight,
+                                  config.genPlatformDensity, config.genEnemyDensity, config.genTiles };
     std::vector<Spear> spears;
+    LevelGeometryCache levelGeometry;
+    GameCamera camera;
 
     // Game loop
-    while(!WindowShouldClose()){
+    int headlessFramesLeft = config.headlessFrames;
+    while(headless ? (headlessFramesLeft-- > 0) : !WindowShouldClose()){
+        TRACE_ZONE("frame");
+        bool enemyGridBuilt = false;
+        BeginPerfFrame(pacer.GetFrameMs(0));
+        BeginPerfPhase(PERF_INPUT);
         // Input handling for state transitions
         if (gameState == GameState::Start) {
-            if (IsKeyPressed(KEY_V)) {
+            if (IsKeyPressed(KEY_G) || (headless && config.generateLevel)) {
+                LoadTimer levelTimer(LOAD_PHASE, "level/Generated");
+                gameState = GameState::Generated;
+                ClearEnemies(enemies);
+                levelGeometry.Invalidate();
+                ClearParticles();
+                ActivateAssetSet(SET_GENERATED);
+                GenerateLevel(levelGen, level);
+                levelGen.seed++;
+                beginLevel();
+                LoadLevelSfx(HUNTRESS_LEVEL_SFX, sizeof(HUNTRESS_LEVEL_SFX) / sizeof(HUNTRESS_LEVEL_SFX[0]));
+                hud.SetBoss(nullptr);
+                fighter.Reset();
+                camera.Reset(fighter.GetRect());
+            }
+            else if (IsKeyPressed(KEY_V) || headless) {
+                LoadTimer levelTimer(LOAD_PHASE, "level/Level1");
                 gameState = GameState::Level1;
                 // Initialize Level 1
                 ClearEnemies(enemies);
-                platforms.clear();
-                CreateLevel1Platforms(platforms, screenWidth, screenHeight, groundHeight);
-                SpawnLevel1Enemies(enemies, screenWidth, screenHeight);
+                levelGeometry.Invalidate();
+                ClearParticles();
+                ActivateAssetSet(SET_LEVEL1);
+                PrefetchAssetSet(SET_LEVEL2);
+                enterLevel(0);
+                LoadLevelSfx(LEVEL_SFX, sizeof(LEVEL_SFX) / sizeof(LEVEL_SFX[0]));
+                hud.SetBoss(nullptr);
                 fighter.Reset();
+                camera.Reset(fighter.GetRect());
             }
         } 
         else if (gameState == GameState::Pause) {
@@ -147,14 +376,18 @@ int main()
         else if (gameState == GameState::Level1) {
             if (Enemy::allEnemiesDefeated(enemies)) {
                 // All enemies defeated, proceed to next level
+                LoadTimer levelTimer(LOAD_PHASE, "level/Level2");
                 gameState = GameState::Level2;
                 // Initialize Level 2
                 fighter.resetPos();
+                camera.Reset(fighter.GetRect());
                 ClearEnemies(enemies);
-                platforms.clear();
-                CreateLevel2Platforms(platforms, screenWidth, screenHeight, groundHeight);
-                SpawnLevel2Enemies(enemies, screenWidth, screenHeight);
-                StopMusicStream(level1Music);
+                levelGeometry.Invalidate();
+                ClearParticles();
+                ActivateAssetSet(SET_LEVEL2);
+                PrefetchAssetSet(SET_LEVEL3);
+                enterLevel(1);
+                LoadLevelSfx(LEVEL_SFX, sizeof(LEVEL_SFX) / sizeof(LEVEL_SFX[0]));
             }
             if (IsKeyPressed(KEY_P)) {
                 prevState = GameState::Level1;
@@ -164,15 +397,18 @@ int main()
         else if (gameState == GameState::Level2) {
             if (Enemy::allEnemiesDefeated(enemies)) {
                 // All enemies defeated, proceed to next level
+                LoadTimer levelTimer(LOAD_PHASE, "level/Level3");
                 gameState = GameState::Level3;
                 // Initialize Level 3
                 fighter.resetPos();
+                camera.Reset(fighter.GetRect());
                 ClearEnemies(enemies);
-                platforms.clear();
-                walls.clear();
-                CreateLevel3Platforms(platforms, walls, screenWidth, screenHeight, groundHeight);
-                SpawnLevel3Enemies(enemies, screenWidth, screenHeight);
-                StopMusicStream(level2Music);
+                levelGeometry.Invalidate();
+                ClearParticles();
+                ActivateAssetSet(SET_LEVEL3);
+                PrefetchAssetSet(SET_BOSS);
+                enterLevel(2);
+                LoadLevelSfx(HUNTRESS_LEVEL_SFX, sizeof(HUNTRESS_LEVEL_SFX) / sizeof(HUNTRESS_LEVEL_SFX[0]));
             }
             if (IsKeyPressed(KEY_P)) {
                 prevState = GameState::Level2;
@@ -182,16 +418,24 @@ int main()
         else if (gameState == GameState::Level3) {
             if (Enemy::allEnemiesDefeated(enemies)) {
                 // All enemies defeated, proceed to next level
+                LoadTimer levelTimer(LOAD_PHASE, "level/BossLevel");
                 gameState = GameState::BossLevel;
                 // Initialize Boss level
                 fighter.resetPos();
+                camera.Reset(fighter.GetRect());
                 fighter.speed = 7; //increased speed for boss level
                 ClearEnemies(enemies);
-                platforms.clear();
-                walls.clear();
-                CreateBossLevelPlatforms(platforms, walls, screenWidth, screenHeight, groundHeight);
-                SpawnBossLevelEnemies(enemies, screenWidth, screenHeight);
-                StopMusicStream(level3Music);
+                levelGeometry.Invalidate();
+                ClearParticles();
+                ActivateAssetSet(SET_BOSS);
+                PrefetchAssetSet(SET_MENU);     // winning returns to the menu
+                enterLevel(3);
+                LoadLevelSfx(BOSS_LEVEL_SFX, sizeof(BOSS_LEVEL_SFX) / sizeof(BOSS_LEVEL_SFX[0]));
+                Boss* boss = nullptr;
+                for (auto* enemy : enemies) {
+                    if (boss == nullptr) boss = dynamic_cast<Boss*>(enemy);
+                }
+                hud.SetBoss(boss);
             }
             if (IsKeyPressed(KEY_P)) {
                 prevState = GameState::Level3;
@@ -204,18 +448,35 @@ int main()
                 gameState = GameState::GameWon;
                 gameWonTimer = 0.0f;
                 gameWonTextY = -200.0f;
-                StopMusicStream(bossLevelMusic);
             }
             if (IsKeyPressed(KEY_P)) {
                 prevState = GameState::BossLevel;
                 gameState = GameState::Pause;
             }
         }
+        else if (gameState == GameState::Generated) {
+            if (Enemy::allEnemiesDefeated(enemies) && streamer.GetStreamedEnemyCount() == 0) {
+                gameState = GameState::GameWon;
+                gameWonTimer = 0.0f;
+                gameWonTextY = -200.0f;
+            }
+            if (IsKeyPressed(KEY_P)) {
+                prevState = GameState::Generated;
+                gameState = GameState::Pause;
+            }
+        }
 
         // Toggle volume slider with tilde/grave key
         if (IsKeyPressed(KEY_GRAVE)) {
             volumeSliderActive = !volumeSliderActive;
         }
+        if (IsKeyPressed(KEY_F3)) {
+            TogglePerfOverlay();
+        }
+        // Dump the recent timeline right after a hitch
+        if (IsKeyPressed(KEY_F4)) {
+            WriteTrace(config.traceFile.c_str());
+        }
 
         // Adjust master volume when slider is active
         if (volumeSliderActive) {
@@ -230,6 +491,7 @@ int main()
         }
 
         // Konami code detection
+        BeginPerfPhase(PERF_CHEATS);
         if (!volumeSliderActive && !konamiActivated) {
             if (IsKeyPressed(KONAMI_CODE[konamiProgress])) {
                 konamiProgress++;
@@ -246,103 +508,39 @@ int main()
             }
         }
 
-        // Update music streams
-        UpdateMusicStream(menuMusic);
-        UpdateMusicStream(level1Music);
-        UpdateMusicStream(level2Music);
-        UpdateMusicStream(level3Music);
-        UpdateMusicStream(bossLevelMusic);
-        UpdateMusicStream(gameOverMusic);
-        UpdateMusicStream(gameWonMusic);
-
-        // Music control per game state
-        if (gameState == GameState::Start) {
-            // Play menu music; ensure others are stopped
-            StopMusicStream(level1Music);
-            StopMusicStream(gameOverMusic);
-            ResumeMusicStream(menuMusic);
-            if (!IsMusicStreamPlaying(menuMusic)) {
-                PlayMusicStream(menuMusic);
-            }
+        BeginPerfPhase(PERF_MUSIC);
+        // Music per game state: entering a state crossfades to its track, and the track that usually
+        // follows is pre-decoded in the background
+        if (gameState == GameState::Pause) {
+            music.Pause();
+        } else if (gameState == GameState::Start) {
+            music.Play(MUSIC_MENU);
+            music.Prefetch(MUSIC_LEVEL1);
         } else if (gameState == GameState::Level1) {
-            // Play level 1 music; ensure menu/gameover are stopped
-            StopMusicStream(menuMusic);
-            StopMusicStream(gameOverMusic);
-            ResumeMusicStream(level1Music);
-            if (!IsMusicStreamPlaying(level1Music)) {
-                PlayMusicStream(level1Music);
-            }
-        } 
-        else if (gameState == GameState::Level2) {
-            // Play level 2 music;
-            StopMusicStream(menuMusic);
-            StopMusicStream(gameOverMusic);
-            StopMusicStream(level1Music);
-            ResumeMusicStream(level2Music);
-            if (!IsMusicStreamPlaying(level2Music)) {
-                PlayMusicStream(level2Music);
-            }
-        } 
-        else if (gameState == GameState::Level3) {
-            // Play level 3 music;
-            StopMusicStream(menuMusic);
-            StopMusicStream(level2Music);
-            StopMusicStream(level1Music);
-            ResumeMusicStream(level3Music);
-            if (!IsMusicStreamPlaying(level3Music)) {
-                PlayMusicStream(level3Music);
-            }
-        } 
-        else if (gameState == GameState::BossLevel) {
-            // Play boss level music;
-            StopMusicStream(menuMusic);
-            StopMusicStream(level2Music);
-            StopMusicStream(level1Music);
-            StopMusicStream(level3Music);
-            ResumeMusicStream(bossLevelMusic);
-            if (!IsMusicStreamPlaying(bossLevelMusic)) {
-                PlayMusicStream(bossLevelMusic);
-            }
-        }
-        else if (gameState == GameState::Pause) {
-            // No music while paused
-            PauseMusicStream(menuMusic);
-            PauseMusicStream(level1Music);
-            PauseMusicStream(level2Music);
-            PauseMusicStream(level3Music);
-            PauseMusicStream(bossLevelMusic);
-            PauseMusicStream(gameOverMusic);
+            music.Play(levelMusic);
+            music.Prefetch(MUSIC_LEVEL2);
+        } else if (gameState == GameState::Level2) {
+            music.Play(levelMusic);
+            music.Prefetch(MUSIC_LEVEL3);
+        } else if (gameState == GameState::Level3) {
+            music.Play(levelMusic);
+            music.Prefetch(MUSIC_BOSS);
+        } else if (gameState == GameState::BossLevel || gameState == GameState::Generated) {
+            music.Play(levelMusic);
+            music.Prefetch(MUSIC_GAME_WON);
         } else if (gameState == GameState::GameOver) {
-            // Play game over music; stop others
-            StopMusicStream(menuMusic);
-            StopMusicStream(level1Music);
-            StopMusicStream(level2Music);
-            StopMusicStream(level3Music);
-            StopMusicStream(bossLevelMusic);
-
-            ResumeMusicStream(gameOverMusic);
-            if (!IsMusicStreamPlaying(gameOverMusic)) {
-                PlayMusicStream(gameOverMusic);
-            }
-        }
-        else if (gameState == GameState::GameWon) {
-            // Play game won music; stop others
-            StopMusicStream(menuMusic);
-            StopMusicStream(level1Music);
-            StopMusicStream(level2Music);
-            StopMusicStream(level3Music);
-            StopMusicStream(bossLevelMusic);
-
-            ResumeMusicStream(gameWonMusic);
-            if (!IsMusicStreamPlaying(gameWonMusic)) {
-                PlayMusicStream(gameWonMusic);
-            }
+            music.Play(MUSIC_GAME_OVER);
+        } else if (gameState == GameState::GameWon) {
+            music.Play(MUSIC_GAME_WON);
         }
+        music.Update(GetGameFrameTime());
+        EndPerfPhase();
 
         // Update (during gameplay and not when slider is active)
         if ((gameState != GameState::Start && gameState != GameState::GameOver && gameState != GameState::Pause) && !volumeSliderActive)
         {
             // Handle cheat phrase typing
+            BeginPerfPhase(PERF_CHEATS);
             int ch = GetCharPressed();
             while (ch > 0) {
                 char c = (char)std::tolower(ch);
@@ -363,14 +561,24 @@ int main()
                 ch = GetCharPressed();
             }
 
+            BeginPerfPhase(PERF_GEOMETRY);
+            if (streamer.Update(camera.GetView(), enemies)) {
+                levelGeometry.Invalidate();
+            }
+            BeginPerfPhase(PERF_FIGHTER);
             fighter.Update(platforms, walls);
+            camera.Follow(fighter.GetRect(), GetGameFrameTime());
             // Update all enemies
+            BeginPerfPhase(PERF_ENEMIES);
             for (auto* enemy : enemies) {
                 if (!enemy->IsDead()) {
                     enemy->Update(platforms, walls, fighter);
                 }
             }
+            BuildEnemyGrid(enemyGrid, enemies);
+            enemyGridBuilt = true;
             // Check if fighter is attacking and deal damage to all enemies
+            BeginPerfPhase(PERF_COMBAT);
             if (fighter.IsAttacking()) {
                 for (auto* enemy : enemies) {
                     if (!enemy->IsDead()) {
@@ -383,28 +591,32 @@ int main()
                 }
             }
             fighter.characterDeath(enemies);
+            EndPerfPhase();
+            UpdateParticles(GetGameFrameTime());
+            UpdateSfx();
             // Check for game over
             if (fighter.lives < 0) {
                 gameState = GameState::GameOver;
                 gameOverTimer = 0.0f;
                 gameOverTextY = -200.0f;
+                PrefetchAssetSet(SET_MENU);
             }
         }
         
         // Update GameOver state
         if (gameState == GameState::GameOver) {
-            DrawRectangleGradientEx(
+            gfx.DrawRectangleGradientEx(
                 {0, 0, (float)screenWidth, (float)screenHeight},
                 RED,
                 ORANGE,
                 DARKGRAY,
                 MAROON
             );
-            gameOverTimer += GetFrameTime();      
+            gameOverTimer += GetGameFrameTime();      
             // text animation
             float targetY = (screenHeight - 120) / 2.0f;
             if (gameOverTextY < targetY) {
-                gameOverTextY += 800.0f * GetFrameTime(); // Fall speed
+                gameOverTextY += 800.0f * GetGameFrameTime(); // Fall speed
                 if (gameOverTextY > targetY) {
                     gameOverTextY = targetY;
                 }
@@ -412,19 +624,26 @@ int main()
             
             // After 10 seconds, return to start
             if (gameOverTimer >= 10.0f) {
+                LoadTimer levelTimer(LOAD_PHASE, "level/Start");
                 gameState = GameState::Start;
                 // Clean up for restart
                 ClearEnemies(enemies);
+                streamer.End();
                 platforms.clear();
+                level.tiles.Clear();
+                levelGeometry.Invalidate();
+                ClearParticles();
+                ActivateAssetSet(SET_MENU);
+                PrefetchAssetSet(SET_LEVEL1);
             }
         }
         // Update GameWon state
         if (gameState == GameState::GameWon) {
-            gameWonTimer += GetFrameTime();      
+            gameWonTimer += GetGameFrameTime();      
             // text animation
             float targetY = (screenHeight - 120) / 2.0f;
             if (gameWonTextY < targetY) {
-                gameWonTextY += 800.0f * GetFrameTime(); // Fall speed
+                gameWonTextY += 800.0f * GetGameFrameTime(); // Fall speed
                 if (gameWonTextY > targetY) {
                     gameWonTextY = targetY;
                 }
@@ -432,32 +651,50 @@ int main()
             
             // After 10 seconds, return to start
             if (gameWonTimer >= 10.0f) {
+                LoadTimer levelTimer(LOAD_PHASE, "level/Start");
                 gameState = GameState::Start;
                 // Clean up for restart
                 ClearEnemies(enemies);
+                streamer.End();
                 platforms.clear();
-                StopMusicStream(gameWonMusic);
+                level.tiles.Clear();
+                levelGeometry.Invalidate();
+                ClearParticles();
+                ActivateAssetSet(SET_MENU);
+                PrefetchAssetSet(SET_LEVEL1);
                 gameWonTimer = 0.0f;
                 gameWonTextY = -200.0f;
             }
         }
 
-        // Drawing
-        BeginDrawing();
-        ClearBackground(BLACK);
+        // Composite the active background stack (must happen outside BeginDrawing)
+        BeginPerfPhase(PERF_BACKGROUND);
+        if (IsWindowResized()) {
+            backgrounds.Invalidate();
+        }
+        BackgroundStack backgroundStack = (gameState == GameState::Start) ? BG_MENU : levelBackground;
+        backgrounds.Prepare(backgroundStack);
+
+        // Re-bake level geometry after a level change or resize (must happen outside BeginDrawing)
+        BeginPerfPhase(PERF_GEOMETRY);
+        if (gameState != GameState::Start && (!levelGeometry.IsValid() || IsWindowResized())) {
+            levelGeometry.Rebuild(platforms, walls, FindTexture(TILESET.fileName), tileWidth, tileHeight, tileRow, tileCol, wallWidth, wallHeight, wallRow, wallCol);
+        }
+
+        // Drawing (into the internal render target, in layout coordinates)
+        gfx.BeginTextureMode(frameTarget);
+        gfx.ClearBackground(BLACK);
+        gfx.BeginMode2D(uiCamera);
+        EndPerfPhase();
 
         if (gameState == GameState::Start) {
             // Draw only background image, game logo and start text
-            DrawTexturePro(
-                background,
-                {0, 0, (float)background.width, (float)background.height},
-                {0, 0, (float)screenWidth, (float)screenHeight},
-                {0, 0},
-                0.0f,
-                WHITE
-            );
+            BeginPerfPhase(PERF_BACKGROUND);
+            backgrounds.Draw(backgroundStack);
+            BeginPerfPhase(PERF_HUD);
 
-            DrawTexturePro(
+            Texture2D gameLogo = FindTexture(GAME_LOGO.fileName);
+            gfx.DrawTexturePro(
                 gameLogo,
                 {0, 0, (float)gameLogo.width, (float)gameLogo.height},
                 {((float)screenWidth - (float)gameLogo.width * 0.75f) / 2, ((float)screenHeight - (float)gameLogo.height* 0.75f) / 3, (float)gameLogo.width* 0.75f , (float)gameLogo.height* 0.75f },
@@ -471,6 +708,11 @@ int main()
             int promptWidth = MeasureText(prompt, promptFontSize);
             int promptX = (screenWidth - promptWidth) / 2;
             int promptY = screenHeight - 200;
+            // Second, smaller line so both fit the 1920 layout width
+            const char* generatedPrompt = "or g for a generated level";
+            int generatedFontSize = 48;
+            int generatedX = (screenWidth - MeasureText(generatedPrompt, generatedFontSize)) / 2;
+            int generatedY = promptY + promptFontSize + 12;
             const char* cred = "Made by Faizan Ali with <3";
             int credFontSize = 72;
             int credWidth = MeasureText(cred, credFontSize);
@@ -479,15 +721,16 @@ int main()
             Vector2 credPos = { (float)credX, (float)credY };
             
             // Flashy prompt text with alpha oscillation
-            float time = GetTime();
+            float time = GetGameTime();
             float alpha = (sin(time * 3.0f) + 1.0f) / 2.0f; // Oscillates between 0 and 1
             alpha = alpha * 0.7f + 0.3f; // Clamp between 0.3 and 1.0 for better visibility
             Color flashyYellow = { 255, 214, 0, (unsigned char)(alpha * 255) };
-            DrawText(prompt, promptX, promptY, promptFontSize, flashyYellow);
+            gfx.DrawText(prompt, promptX, promptY, promptFontSize, flashyYellow);
+            gfx.DrawText(generatedPrompt, generatedX, generatedY, generatedFontSize, flashyYellow);
             
             float alpha2 = (cos(time * 3.0f) + 1.0f) / 2.0f; // Oscillates between 0 and 1
             Color flashyGreen = { 0, 255, 41, (unsigned char)(alpha2 * 255) };
-            DrawTextPro(fnt_chewy, cred,  credPos, {0,0}, -30.0f,  credFontSize, 1.0f,  flashyGreen);
+            gfx.DrawTextPro(fnt_chewy, cred,  credPos, {0,0}, -30.0f,  credFontSize, 1.0f,  flashyGreen);
             
             // Volume slider UI (bottom of screen)
             if (volumeSliderActive) {
@@ -495,131 +738,66 @@ int main()
                 int sliderHeight = 12;
                 int sliderX = (screenWidth - sliderWidth) / 2;
                 int sliderY = screenHeight - 40;
-                DrawRectangle(sliderX, sliderY, sliderWidth, sliderHeight, GRAY);
-                DrawRectangle(sliderX, sliderY, (int)(sliderWidth * masterVolume), sliderHeight, RAYWHITE);
-                DrawRectangleLines(sliderX, sliderY, sliderWidth, sliderHeight, LIGHTGRAY);
+                gfx.DrawRectangle(sliderX, sliderY, sliderWidth, sliderHeight, GRAY);
+                gfx.DrawRectangle(sliderX, sliderY, (int)(sliderWidth * masterVolume), sliderHeight, RAYWHITE);
+                gfx.DrawRectangleLines(sliderX, sliderY, sliderWidth, sliderHeight, LIGHTGRAY);
             }
         }
         else {
-            // Draw background layers for gameplay and pause
-                DrawTexturePro(
-                    background,
-                    {0, 0, (float)background.width, (float)background.height},
-                    {0, 0, (float)screenWidth, (float)screenHeight},
-                    {0, 0},
-                    0.0f,
-                    WHITE
-                );
-                DrawTexturePro(
-                    midground,
-                    {0, 0, (float)midground.width, (float)midground.height},
-                    {0, 0, (float)screenWidth, (float)screenHeight},
-                    {0, 0},
-                    0.0f,
-                    WHITE
-                );
-                DrawTexturePro(
-                    foreground,
-                    {0, 0, (float)foreground.width, (float)foreground.height},
-                    {0, 0, (float)screenWidth, (float)screenHeight},
-                    {0, 0},
-                    0.0f,
-                    WHITE
-                );
-
-                if(gameState == GameState::BossLevel || gameState == GameState::GameWon) {
-                DrawTexturePro(
-                    bossBG,
-                    {0, 0, (float)bossBG.width, (float)bossBG.height},
-                    {0, 0, (float)screenWidth, (float)screenHeight},
-                    {0, 0},
-                    0.0f,
-                    WHITE
-                );
-            }
-
-            // Draw all platforms
-            for (auto& platform : platforms) {
-                platform.Draw(tileset, tileWidth, tileHeight, tileRow, tileCol);
-            }
-            // Draw all walls
-            for (auto& wall : walls) {
-                wall.Draw(tileset, wallWidth, wallHeight, wallRow, wallCol);
-            }
+            // Draw background layers for gameplay and pause (one cached fill)
+            BeginPerfPhase(PERF_BACKGROUND);
+            backgrounds.Draw(backgroundStack, camera.Get().target);
+
+            // World-space pass: level geometry, character and enemies seen by the camera
+            gfx.EndMode2D();
+            gfx.BeginMode2D(camera.GetScaled(renderScale));
+            BeginPerfPhase(PERF_GEOMETRY);
+            levelGeometry.Draw(camera.GetView());
+            level.tiles.Draw(FindTexture(TILESET.fileName), camera.GetView());
+
+            BeginPerfPhase(PERF_ENTITIES);
+            fighter.Draw();
+            // No update this frame (paused, game over, volume slider): enemies may have changed since
+            if (!enemyGridBuilt) BuildEnemyGrid(enemyGrid, enemies);
+            // Margin covers sprites drawn outside their rect (boss flip offset, spells)
+            const float margin = 512.0f;
+            Rectangle view = GetWorldView();
+            enemyGrid.Query({view.x - margin, view.y - margin, view.width + 2.0f * margin, view.height + 2.0f * margin}, visibleEnemies);
+            std::sort(visibleEnemies.begin(), visibleEnemies.end()); // keep the list's draw order
+            for (int id : visibleEnemies) {
+                enemies[id]->Draw();
+            }
+            DrawParticles();
+            gfx.EndMode2D();
+            gfx.BeginMode2D(uiCamera);
+            BeginPerfPhase(PERF_HUD);
 
             // HUD texts (only shown during gameplay & pause)
             if (gameState != GameState::Start && gameState != GameState::GameOver) {
-            std::string livesCount = "Lives: " + std::to_string(fighter.lives);
-            std::string invin;
-            if (gameState == GameState::Level1){
-                invin = "Stage 1";
-            }
-            else if (gameState == GameState::Level2){
-                invin = "Stage 2";
-            }
-            else if (gameState == GameState::Level3){
-                invin = "Stage 3";
-            }
-            else if (gameState == GameState::BossLevel){
-                invin = "Boss Level";
-            }
-        
-            float fontSpacing = 3.0f;
-
-            Vector2 textSize1 = MeasureTextEx(fnt_chewy, livesCount.c_str(), HUDfontSize, fontSpacing);
-            Vector2 textPosition1 = { 50.0f , 20.0f };
-            DrawTextEx(fnt_chewy, livesCount.c_str(), textPosition1, HUDfontSize, fontSpacing, WHITE);
-
-            Vector2 textSize2 = MeasureTextEx(fnt_chewy, invin.c_str(), HUDfontSize, fontSpacing);
-            Vector2 textPosition2 = {(float)screenWidth - textSize2.x - 50.0f, 20.0f };
-            DrawTextEx(fnt_chewy, invin.c_str(), textPosition2, HUDfontSize, fontSpacing, WHITE);
-            
-            // Boss health bar for Boss Level
-            if (gameState == GameState::BossLevel) {
-                for (auto* enemy : enemies) {
-                    Boss* boss = dynamic_cast<Boss*>(enemy);
-                    if (boss && !boss->IsDead()) {
-                        float bossHealth = boss->GetHealth();
-                        float maxHealth = 500.0f; // Assuming boss max health is 500
-                        float healthPercent = bossHealth / maxHealth;
-                        
-                        // Boss health bar
-                        float barWidth = 900.0f;
-                        float barHeight = 8.0f;
-                        float barX = (screenWidth - barWidth) / 2.0f;
-                        float barY = 120.0f;
-    
-                        // Background bar (red)
-                        DrawRectangle(barX, barY, barWidth, barHeight, DARKGRAY);
-                        // Health bar (green to red gradient based on health)
-                        Color healthColor = healthPercent > 0.5f ? GREEN : (healthPercent > 0.25f ? YELLOW : RED);
-                        DrawRectangle(barX, barY, barWidth * healthPercent, barHeight, healthColor);
-                        DrawRectangleLines(barX, barY, barWidth, barHeight, WHITE);
-                        
-                        // Boss name
-                        const char* bossName = "BRINGER OF DEATH";
-                        Vector2 bossNameSize = MeasureTextEx(fnt_chewy, bossName, HUDfontSize * 1.75f, fontSpacing);
-                        Vector2 bossNamePos = { barX + (barWidth - bossNameSize.x) / 2.0f, barY - bossNameSize.y - 5.0f };
-                        DrawTextEx(fnt_chewy, bossName, bossNamePos, HUDfontSize * 1.75f, fontSpacing, RED);
-                        
-                        break; // Only draw for first boss found
-                    }
+                const char* stageLabel = "";
+                if (gameState == GameState::Level1) {
+                    stageLabel = "Stage 1";
                 }
-            }
-            }
-
-            // Draw Character and enemies
-            fighter.Draw();
-            for (auto* enemy : enemies) {
-                if (!enemy->IsDead()) {
-                    enemy->Draw();
+                else if (gameState == GameState::Level2) {
+                    stageLabel = "Stage 2";
+                }
+                else if (gameState == GameState::Level3) {
+                    stageLabel = "Stage 3";
+                }
+                else if (gameState == GameState::BossLevel) {
+                    stageLabel = "Boss Level";
                 }
+                else if (gameState == GameState::Generated) {
+                    stageLabel = "Generated";
+                }
+                hud.Update(fighter.lives, stageLabel);
+                hud.Draw(screenWidth);
             }
 
             if (gameState == GameState::Pause) {
                 // Apply a slight brownish hue overlay and pause text
                 Color brownOverlay = {165, 105, 60, 80};
-                DrawRectangle(0, 0, screenWidth, screenHeight, brownOverlay);
+                gfx.DrawRectangle(0, 0, screenWidth, screenHeight, brownOverlay);
                 
                 // Draw centered "PAUSED" text
                 const char* pausedText = "PAUSED";
@@ -627,31 +805,31 @@ int main()
                 int pausedWidth = MeasureText(pausedText, pausedFontSize);
                 int pausedX = (screenWidth - pausedWidth) / 2;
                 int pausedY = (screenHeight - pausedFontSize) / 2;
-                DrawText(pausedText, pausedX, pausedY, pausedFontSize, RAYWHITE);
+                gfx.DrawText(pausedText, pausedX, pausedY, pausedFontSize, RAYWHITE);
             }
             
             if (gameState == GameState::GameOver) {
                 // Apply grayscale overlay
                 Color grayOverlay = {50, 50, 50, 180};
-                DrawRectangle(0, 0, screenWidth, screenHeight, grayOverlay);
+                gfx.DrawRectangle(0, 0, screenWidth, screenHeight, grayOverlay);
                 
                 // Draw falling "GAME OVER" text in red
                 const char* gameOverText = "GAME OVER";
                 int gameOverFontSize = 120;
                 int gameOverWidth = MeasureText(gameOverText, gameOverFontSize);
                 int gameOverX = (screenWidth - gameOverWidth) / 2;
-                DrawText(gameOverText, gameOverX, (int)gameOverTextY, gameOverFontSize, RED);
+                gfx.DrawText(gameOverText, gameOverX, (int)gameOverTextY, gameOverFontSize, RED);
             }
             if (gameState == GameState::GameWon) {
                 // Apply golden overlay
                 Color goldOverlay = {255, 215, 0, 100};
-                DrawRectangle(0, 0, screenWidth, screenHeight, goldOverlay);
+                gfx.DrawRectangle(0, 0, screenWidth, screenHeight, goldOverlay);
                 // Draw falling "GAME WON" text in gold
                 const char* gameWonText = "GAME WON";
                 int gameWonFontSize = 120;
                 int gameWonWidth = MeasureText(gameWonText, gameWonFontSize);
                 int gameWonX = (screenWidth - gameWonWidth) / 2;
-                DrawText(gameWonText, gameWonX, (int)gameWonTextY, gameWonFontSize, GOLD);
+                gfx.DrawText(gameWonText, gameWonX, (int)gameWonTextY, gameWonFontSize, GOLD);
             }
 
             // Volume slider UI (bottom of screen)
@@ -660,159 +838,125 @@ int main()
                 int sliderHeight = 12;
                 int sliderX = (screenWidth - sliderWidth) / 2;
                 int sliderY = screenHeight - 40;
-                DrawRectangle(sliderX, sliderY, sliderWidth, sliderHeight, GRAY);
-                DrawRectangle(sliderX, sliderY, (int)(sliderWidth * masterVolume), sliderHeight, RAYWHITE);
-                DrawRectangleLines(sliderX, sliderY, sliderWidth, sliderHeight, LIGHTGRAY);
+                gfx.DrawRectangle(sliderX, sliderY, sliderWidth, sliderHeight, GRAY);
+                gfx.DrawRectangle(sliderX, sliderY, (int)(sliderWidth * masterVolume), sliderHeight, RAYWHITE);
+                gfx.DrawRectangleLines(sliderX, sliderY, sliderWidth, sliderHeight, LIGHTGRAY);
             }
         }
 
-        EndDrawing();
+        EndPerfPhase();
+        if (IsPerfOverlayVisible()) {
+            DrawPerfOverlay(20, 140);
+        }
+        gfx.EndMode2D();
+        gfx.EndTextureMode();
+        EndPerfFrame();
+
+        gfx.BeginDrawing();
+        gfx.ClearBackground(BLACK);
+        PresentFrame(frameTarget);
+        pacer.WaitForPresent();
+        gfx.EndDrawing();
+        pacer.EndFrame();
+
+        if (interactiveMs < 0.0) {
+            interactiveMs = millisecondsSinceStart();
+            if (firstFrameMs < 0.0) firstFrameMs = interactiveMs;
+            TraceLog(LOG_INFO, "STARTUP: first frame %.1f ms, interactive %.1f ms", firstFrameMs, interactiveMs);
+            RecordLoadPhase("startup/first-frame", firstFrameMs);
+            RecordLoadPhase("startup/interactive", interactiveMs);
+        }
     }
+    pacer.Report();
+    gfx.Report();
 
     // Clean up enemies
     for (auto* enemy : enemies) {
         delete enemy;
     }
     enemies.clear();
-    Mushroom::UnloadSharedTexture();
-
-    UnloadTexture(background);
-    UnloadTexture(midground);
-    UnloadTexture(foreground);
-    UnloadTexture(bossBG);
-    UnloadTexture(gameLogo);
-    UnloadTexture(tileset);
-    UnloadMusicStream(menuMusic);
-    UnloadMusicStream(level1Music);
-    UnloadMusicStream(level2Music);
-    UnloadMusicStream(level3Music);
-    UnloadMusicStream(bossLevelMusic);
-    UnloadMusicStream(gameOverMusic);
-    UnloadMusicStream(gameWonMusic);
+    ReleaseAssetSets();
+    ReportAssetSets();
+    fighter.UnloadTextures();
+    LogResidentTextures();   // anything still listed here leaked a reference
+    levelGeometry.Unload();
+    UnloadParticles();
+    UnloadSfx();
+    StopAssetLoader();
+    gfx.UnloadRenderTexture(frameTarget);
+    backgrounds.Unload();
+    music.Unload();
     CloseAudioDevice();
-    CloseWindow();
-    return 0;
-}
+    UnmountAssetPack();
+    if (!headless) CloseWindow();
 
-// Level management function implementations
-void ClearEnemies(std::vector<Enemy*>& enemies) {
-    for (auto* enemy : enemies) {
-        delete enemy;
-    }
-    enemies.clear();
+    WriteTrace(config.traceFile.c_str());
+    bool withinBudget = config.loadReport.empty() || WriteLoadReport(config.loadReport.c_str());
+    return (withinBudget || !config.failOverBudget) ? 0 : 1;
 }
 
-void SpawnLevel1Enemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight) {
-    // Level 1: 2 mushrooms and 1 slime
-    enemies.push_back(new Mushroom({400.0f, (float)screenHeight - (160*6)}));
-    enemies.push_back(new Mushroom({1600.0f, (float)screenHeight - 300.0f}));
-    enemies.push_back(new Slime({960.0f, (float)screenHeight - 400.0f}));
+// Upscales the internal frame to the window, centred with black bars: the largest integer scale that
+// fits when that is at least 2x, otherwise a plain fractional fit so a frame only slightly smaller
+// than the window (1080p on 1440p) still fills it instead of sitting at 1x
+void PresentFrame(RenderTexture2D frameTarget)
+{
+    float frameW = (float)frameTarget.texture.width;
+    float frameH = (float)frameTarget.texture.height;
+    float fit = fminf((float)GetScreenWidth() / frameW, (float)GetScreenHeight() / frameH);
+    float scale = (fit >= 2.0f) ? floorf(fit) : fit;
+
+    Rectangle source = {0, 0, frameW, -frameH}; // render textures are stored bottom-up
+    Rectangle dest = {
+        (GetScreenWidth() - frameW * scale) * 0.5f,
+        (GetScreenHeight() - frameH * scale) * 0.5f,
+        frameW * scale,
+        frameH * scale
+    };
+    GetRenderBackend().DrawTexturePro(frameTarget.texture, source, dest, {0, 0}, 0.0f, WHITE);
 }
 
-void SpawnLevel2Enemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight) {
-    // Level 2: 3 mushrooms and 2 slimes
-    enemies.push_back(new Mushroom({1500.0f, (float)screenHeight - 100.0f}));
-    enemies.push_back(new Mushroom({960.0f, (float)screenHeight - 350.0f}));
-    enemies.push_back(new Mushroom({1500.0f, (float)screenHeight - 650.0f}));
-    enemies.push_back(new Slime({700.0f, (float)screenHeight - 300.0f}));
-    enemies.push_back(new Slime({1300.0f, (float)screenHeight - 450.0f}));
-}
-void SpawnLevel3Enemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight) {
-    // Level 3: 2 huntresses
-    enemies.push_back(new Huntress({250.0f, (float)screenHeight - 950.0f}));
-    enemies.push_back(new Huntress({screenWidth - 250.0f, (float)screenHeight - 950.0f}));
-    
-}
-void SpawnBossLevelEnemies(std::vector<Enemy*>& enemies, int screenWidth, int screenHeight) {
-    enemies.push_back(new Boss({1500.0f, (float)screenHeight - 538.0f}));
-}
+// Spinner and progress bar shown while startup assets decode
+void DrawLoadingScreen(float progress, float time)
+{
+    RenderBackend& gfx = GetRenderBackend();
+    int centerX = GetScreenWidth() / 2;
+    int centerY = GetScreenHeight() / 2;
+
+    const int DOTS = 8;
+    for (int i = 0; i < DOTS; i++) {
+        float angle = (float)i / DOTS * 2.0f * PI;
+        float phase = fmodf(time * 1.5f - (float)i / DOTS + 1.0f, 1.0f);
+        Color dot = Fade(RAYWHITE, 1.0f - phase);
+        gfx.DrawRectangle(centerX + (int)(cosf(angle) * 40.0f) - 6, centerY - 60 + (int)(sinf(angle) * 40.0f) - 6, 12, 12, dot);
+    }
 
-void CreateLevel1Platforms(std::vector<Platform>& platforms, int screenWidth, int screenHeight, int groundHeight) {
-    // Ground platform (same for all levels)
-    platforms.push_back(Platform(0, screenHeight - groundHeight, screenWidth, groundHeight, true));
-    
-    // Level 1 specific platforms - vertical towers on sides
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*1), 200, 40, false));
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*2), 200, 40, false));
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*3), 200, 40, false));
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*4), 200, 40, false));
-
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*1), 200, 40, false));
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*2), 200, 40, false));
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*3), 200, 40, false));
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*4), 200, 40, false));
-
-    platforms.push_back(Platform(300, screenHeight - (160*5), screenWidth - 600, 40, false));
-    platforms.push_back(Platform(1100, screenHeight - 300, 400, 40, false));
-    platforms.push_back(Platform(300, screenHeight - 550, 250, 40, false));
+    const int barWidth = 400;
+    const int barHeight = 12;
+    int barX = centerX - barWidth / 2;
+    int barY = centerY + 20;
+    gfx.DrawRectangle(barX, barY, barWidth, barHeight, DARKGRAY);
+    gfx.DrawRectangle(barX, barY, (int)(barWidth * progress), barHeight, RAYWHITE);
+    gfx.DrawText("Loading", barX, barY + 24, 30, RAYWHITE);
 }
 
-void CreateLevel2Platforms(std::vector<Platform>& platforms, int screenWidth, int screenHeight, int groundHeight) {
-    // Ground platform (same for all levels)
-    platforms.push_back(Platform(0, screenHeight - groundHeight, screenWidth, groundHeight, true));
-    
-    // Level 2 specific platforms - scattered pattern with more vertical variety
-    // Left side staircase
-    platforms.push_back(Platform(100, screenHeight - 200, 250, 40, false));
-    platforms.push_back(Platform(200, screenHeight - 350, 250, 40, false));
-    platforms.push_back(Platform(300, screenHeight - 500, 250, 40, false));
-    platforms.push_back(Platform(400, screenHeight - 650, 250, 40, false));
-    
-    // Center platforms
-    platforms.push_back(Platform(screenWidth/2 - 200, screenHeight - 300, 400, 40, false));
-    platforms.push_back(Platform(screenWidth/2 - 150, screenHeight - 600, 300, 40, false));
-    
-    // Right side platforms
-    platforms.push_back(Platform(screenWidth - 450, screenHeight - 400, 300, 40, false));
-    platforms.push_back(Platform(screenWidth - 350, screenHeight - 550, 250, 40, false));
-    platforms.push_back(Platform(screenWidth - 250, screenHeight - 700, 200, 40, false));
-    
-    // Additional scattered platforms
-    platforms.push_back(Platform(600, screenHeight - 800, 200, 40, false));
-    platforms.push_back(Platform(1200, screenHeight - 800, 200, 40, false));
+// Level management function implementations
+void ClearEnemies(std::vector<Enemy*>& enemies) {
+    LoadTimer timer(LOAD_PHASE, "setup/ClearEnemies");
+    for (auto* enemy : enemies) {
+        delete enemy;
+    }
+    enemies.clear();
 }
-void CreateLevel3Platforms(std::vector<Platform>& platforms, std::vector<Wall>& walls, int screenWidth, int screenHeight, int groundHeight) {
-    // Ground platform (same for all levels)
-    platforms.push_back(Platform(0, screenHeight - groundHeight, screenWidth, groundHeight, true));
-    
-    // Level 3 specific platforms - Climbing sections on either side of screen
 
-
-    // Left side platforms
-    platforms.push_back(Platform(screenWidth/2 - 50 - 375, screenHeight - 250, 325, 40, false));
-    platforms.push_back(Platform(0, screenHeight - 400, 350, 40, false));
-    platforms.push_back(Platform(screenWidth/2 - 50 - 375, screenHeight - 550, 325, 40, false));
-    platforms.push_back(Platform(0, screenHeight - 700, 350, 40, false));
-    
-    // Center platform
-    platforms.push_back(Platform(200, screenHeight - 850, screenWidth - 400, 40, false));
-    
-    // // Right side platforms
-    platforms.push_back(Platform(screenWidth/2 + 75, screenHeight - 250, 325, 40, false));
-    platforms.push_back(Platform(screenWidth - 350, screenHeight - 400, 350, 40, false));
-    platforms.push_back(Platform(screenWidth/2 + 75, screenHeight - 550, 325, 40, false));
-    platforms.push_back(Platform(screenWidth - 350, screenHeight - 700, 350, 40, false));
-    
-    // // Additional scattered platforms
-    // platforms.push_back(Platform(600, screenHeight - 800, 200, 40, false));
-    // platforms.push_back(Platform(1200, screenHeight - 800, 200, 40, false));
+// Ids are indices into enemies; dead enemies are left out. The grid reaches a little past the world
+// so enemies knocked over an edge are still found.
+void BuildEnemyGrid(SpatialGrid& grid, const std::vector<Enemy*>& enemies)
+{
+    Rectangle world = GetWorldBounds();
+    grid.Reset({world.x - 512.0f, world.y - 512.0f, world.width + 1024.0f, world.height + 1024.0f});
+    for (int i = 0; i < (int)enemies.size(); i++) {
+        if (enemies[i]->IsDead()) continue;
+        CountPerf(PERF_LIVE_ENEMIES);
+        grid.Insert(i, enemies[i]->GetRect());
+    }
 }
-void CreateBossLevelPlatforms(std::vector<Platform>& platforms, std::vector<Wall>& walls, int screenWidth, int screenHeight, int groundHeight) {
-    // Ground platform (same for all levels)
-    platforms.push_back(Platform(0, screenHeight - groundHeight, screenWidth, groundHeight, true));
-    
-    // Boss level specific platforms - tall walls on sides and central elevated platform
-
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*1), 200, 40, false));
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*2), 200, 40, false));
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*3), 200, 40, false));
-    platforms.push_back(Platform(0, screenHeight - groundHeight - (160*4), 200, 40, false));
-
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*1), 200, 40, false));
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*2), 200, 40, false));
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*3), 200, 40, false));
-    platforms.push_back(Platform(screenWidth - 200, screenHeight - groundHeight - (160*4), 200, 40, false));
-
-    platforms.push_back(Platform(300, screenHeight - (160*5), screenWidth - 600, 40, false));
-
-}
\ No newline at end of file
@@ -1,5 +1,14 @@
 #include "mushroom.hpp"
 #include "fighter.hpp"
+#include "world.hpp"
+#include "particles.hpp"
+#include "sfx.hpp"
+#include "textures.hpp"
+#include "loadtimes.hpp"
+#include "tilemap.hpp"
+#include "perfoverlay.hpp"
+#include "render.hpp"
+#include "trace.hpp"
 #include <raylib.h>
 #include <cmath>
 #include <algorithm>
@@ -15,27 +24,12 @@ static AnimDef MUSHROOM_IDLE  = {1, 0, 6, 8};
 static AnimDef MUSHROOM_DIE   = {2, 0, 6, 10};
 static AnimDef MUSHROOM_HURT  = {3, 0, 3, 10}; 
 
-// Initialize static texture
-Texture2D Mushroom::sharedAtlas = {0};
-
-void Mushroom::LoadSharedTexture()
-{
-    if (sharedAtlas.id == 0) {
-        sharedAtlas = LoadTexture("resources/enemies/mushroom/mushroom_spritesheet.png");
-    }
-}
-
-void Mushroom::UnloadSharedTexture()
-{
-    if (sharedAtlas.id != 0) {
-        UnloadTexture(sharedAtlas);
-        sharedAtlas = {0};
-    }
-}
+const TextureAsset Mushroom::SHEET = {"resources/enemies/mushroom/mushroom_spritesheet.png", 16, 16};
 
 Mushroom::Mushroom()
 {
-    LoadSharedTexture();
+    LoadTimer timer(LOAD_PHASE, "construct/Mushroom");
+    atlas = AcquireAsset(SHEET);
 
     textureWidth  = 16;
     textureHeight = 16;
@@ -44,15 +38,15 @@ Mushroom::Mushroom()
 
     atlasInfo.frameWidth  = textureWidth;
     atlasInfo.frameHeight = textureHeight;
-    atlasInfo.columns     = sharedAtlas.width / textureWidth;
+    atlasInfo.columns     = atlas.width / textureWidth;
 
-    idleAnim = LoadAnim(MUSHROOM_IDLE, sharedAtlas, atlasInfo, true);
-    walkAnim = LoadAnim(MUSHROOM_WALK, sharedAtlas, atlasInfo, true);
-    hurtAnim = LoadAnim(MUSHROOM_HURT, sharedAtlas, atlasInfo, false);
-    dieAnim  = LoadAnim(MUSHROOM_DIE,  sharedAtlas, atlasInfo, false);
+    idleAnim = LoadAnim(MUSHROOM_IDLE, atlas, atlasInfo, true);
+    walkAnim = LoadAnim(MUSHROOM_WALK, atlas, atlasInfo, true);
+    hurtAnim = LoadAnim(MUSHROOM_HURT, atlas, atlasInfo, false);
+    dieAnim  = LoadAnim(MUSHROOM_DIE,  atlas, atlasInfo, false);
 
     // Place on ground 
-    position = { 600.0f, (float)GetScreenHeight() - 300.0f };
+    position = { 600.0f, GetWorldHeight() - 300.0f };
 
     scale  = 5.0f;
     width  = (int)(textureWidth  * scale);
@@ -74,12 +68,13 @@ Mushroom::Mushroom()
 
     state = State::Idle;
     lastState = State::Idle;
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
 }
 
 Mushroom::Mushroom(Vector2 startPos)
 {
-    LoadSharedTexture();
+    LoadTimer timer(LOAD_PHASE, "construct/Mushroom");
+    atlas = AcquireAsset(SHEET);
 
     textureWidth  = 16;
     textureHeight = 16;
@@ -88,12 +83,12 @@ Mushroom::Mushroom(Vector2 startPos)
 
     atlasInfo.frameWidth  = textureWidth;
     atlasInfo.frameHeight = textureHeight;
-    atlasInfo.columns     = sharedAtlas.width / textureWidth;
+    atlasInfo.columns     = atlas.width / textureWidth;
 
-    idleAnim = LoadAnim(MUSHROOM_IDLE, sharedAtlas, atlasInfo, true);
-    walkAnim = LoadAnim(MUSHROOM_WALK, sharedAtlas, atlasInfo, true);
-    hurtAnim = LoadAnim(MUSHROOM_HURT, sharedAtlas, atlasInfo, false);
-    dieAnim  = LoadAnim(MUSHROOM_DIE,  sharedAtlas, atlasInfo, false);
+    idleAnim = LoadAnim(MUSHROOM_IDLE, atlas, atlasInfo, true);
+    walkAnim = LoadAnim(MUSHROOM_WALK, atlas, atlasInfo, true);
+    hurtAnim = LoadAnim(MUSHROOM_HURT, atlas, atlasInfo, false);
+    dieAnim  = LoadAnim(MUSHROOM_DIE,  atlas, atlasInfo, false);
 
     // Use provided starting position
     position = startPos;
@@ -118,7 +113,7 @@ Mushroom::Mushroom(Vector2 startPos)
 
     state = State::Idle;
     lastState = State::Idle;
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
 }
 
 Mushroom::~Mushroom()
@@ -127,14 +122,14 @@ Mushroom::~Mushroom()
     DisposeSpriteAnimation(walkAnim);
     DisposeSpriteAnimation(hurtAnim);
     DisposeSpriteAnimation(dieAnim);
-    // Do not unload shared texture - managed by LoadSharedTexture/UnloadSharedTexture
+    ReleaseTexture(atlas);
 }
 
 void Mushroom::SetState(State newState)
 {
     if (state != newState) {
         state = newState;
-        animationStartTime = GetTime();
+        animationStartTime = GetGameTime();
         lastState = newState;
     }
 }
@@ -149,8 +144,12 @@ void Mushroom::TakeDamage(float damageAmount)
         health = 0;
         isDying = true;
         SetState(State::Die);
+        EmitDeathBurst(GetHitbox(), Color{214, 186, 140, 255});
+        PlaySfx(SFX_ENEMY_DEATH);
     } else {
         SetState(State::Hurt);
+        EmitHitBurst(GetHitbox(), Color{214, 186, 140, 255});
+        PlaySfx(SFX_HIT);
         hurtTimer = 0.4f; // Hurt animation duration
     }
 }
@@ -163,8 +162,9 @@ Rectangle Mushroom::GetRect() const
 
 Rectangle Mushroom::GetHitbox() const
 {
-    Rectangle rect = { position.x, position.y, (float)width, (float)height };
-    return rect;
+    // Follows the opaque bounds of the current animation frame
+    float elapsed = GetGameTime() - animationStartTime;
+    return GetSpriteAnimationBox(CurrentAnimation(), GetRect(), facingRight, elapsed);
 }
 
 bool Mushroom::CheckPlatformCollision(const std::vector<Platform>& platforms)
@@ -173,7 +173,19 @@ bool Mushroom::CheckPlatformCollision(const std::vector<Platform>& platforms)
     bool grounded = false;
     hasPlatformSupport = false;
 
+    const TileMap* tiles = GetActiveTileMap();
+    TileSurface surface;
+    if (tiles != nullptr && speedY >= 0 && tiles->FindSurface(rect, false, surface)) {
+        position.y = surface.rect.y - height;
+        speedY = 0.0f;
+        hasPlatformSupport = true;
+        // Enough of the run to see an edge within this frame's step
+        currentPlatformRect = tiles->ExtendSurface(surface.rect, (float)(width + speed), false);
+        return true;
+    }
+
     for (const auto& platform : platforms) {
+        CountPerf(PERF_COLLISION_TESTS);
         Rectangle platformRect = platform.GetRect();
 
         if (speedY >= 0 &&
@@ -199,8 +211,9 @@ bool Mushroom::CheckPlatformCollision(const std::vector<Platform>& platforms)
 
 void Mushroom::Update(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player)
 {
+    TRACE_ZONE("Mushroom::Update");
     const float GRAVITY = 800.0f;
-    float dt = GetFrameTime();
+    float dt = GetGameFrameTime();
 
     // Update hurt timer
     if (hurtTimer > 0.0f) {
@@ -213,7 +226,7 @@ void Mushroom::Update(const std::vector<Platform>& platforms, const std::vector<
     // If dying, skip AI and only handle animation
     if (isDying) {
         float dieAnimDuration = (float)dieAnim.rectanglesCount / (float)dieAnim.framesPerSecond;
-        if (GetTime() - animationStartTime >= dieAnimDuration) {
+        if (GetGameTime() - animationStartTime >= dieAnimDuration) {
             // mark fully dead after death animation finishes
             isDeadFinal = true;
         }
@@ -227,9 +240,9 @@ void Mushroom::Update(const std::vector<Platform>& platforms, const std::vector<
         position.y += speedY * dt;
         isOnGround = CheckPlatformCollision(platforms);
         
-        int screenH = GetScreenHeight();
-        if (position.y + height >= screenH) {
-            position.y = screenH - height;
+        float worldH = GetWorldHeight();
+        if (position.y + height >= worldH) {
+            position.y = worldH - height;
             speedY = 0.0f;
             isOnGround = true;
         }
@@ -285,10 +298,10 @@ void Mushroom::Update(const std::vector<Platform>& platforms, const std::vector<
         position.x = clamp(position.x, minX, maxX);
     }
 
-    // stick to bottom of screen
-    int screenH = GetScreenHeight();
-    if (position.y + height >= screenH) {
-        position.y = screenH - height;
+    // stick to bottom of the world
+    float worldH = GetWorldHeight();
+    if (position.y + height >= worldH) {
+        position.y = worldH - height;
         speedY = 0.0f;
         isOnGround = true;
     }
@@ -296,22 +309,18 @@ void Mushroom::Update(const std::vector<Platform>& platforms, const std::vector<
 
 void Mushroom::Draw()
 {
-    float elapsed = GetTime() - animationStartTime;
+    TRACE_ZONE("Mushroom::Draw");
+    float elapsed = GetGameTime() - animationStartTime;
     Vector2 origin{0,0};
-    Rectangle dest = GetRect();
+    DrawSpriteAnimationPro(CurrentAnimation(), GetRect(), origin, 0.0f, WHITE, facingRight, elapsed);
+}
 
+const spriteAnimation& Mushroom::CurrentAnimation() const
+{
     switch (state) {
-        case State::Idle:
-            DrawSpriteAnimationPro(idleAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Walk:
-            DrawSpriteAnimationPro(walkAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Hurt:
-            DrawSpriteAnimationPro(hurtAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
-        case State::Die:
-            DrawSpriteAnimationPro(dieAnim, dest, origin, 0.0f, WHITE, facingRight, elapsed);
-            break;
+        case State::Walk: return walkAnim;
+        case State::Hurt: return hurtAnim;
+        case State::Die:  return dieAnim;
+        default:          return idleAnim;
     }
 }
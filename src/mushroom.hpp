@@ -4,6 +4,7 @@
 #include "platform.hpp"
 #include "animation.h"
 #include "enemy.hpp"
+#include "textures.hpp"
 
 // Forward declaration to avoid circular dependency
 class Fighter;
@@ -14,9 +15,7 @@ public:
     Mushroom(Vector2 startPos);
     virtual ~Mushroom() override;
 
-    // Static texture management
-    static void LoadSharedTexture();
-    static void UnloadSharedTexture();
+    static const TextureAsset SHEET;    // kept resident by the level asset sets
 
     // Override Enemy interface
     void Update(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player) override;
@@ -26,10 +25,13 @@ public:
     void TakeDamage(float damageAmount) override;
     bool IsDead() const override { return isDeadFinal; }
     float GetHealth() const override { return health; }
+    void RestoreHealth(float value) override { health = value; }
     
 private:
+    friend struct BenchAccess;  // tools/bench.cpp times the collision helpers directly
+
     // Textures & animations
-    static Texture2D sharedAtlas;
+    Texture2D atlas;
     AtlasInfo atlasInfo;
     spriteAnimation idleAnim;
     spriteAnimation walkAnim;
@@ -70,4 +72,5 @@ private:
     // Internals
     bool CheckPlatformCollision(const std::vector<Platform>& platforms);
     void SetState(State newState);
+    const spriteAnimation& CurrentAnimation() const;
 };
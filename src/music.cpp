@@ -0,0 +1,335 @@
+#include "music.hpp"
+#include "ringbuffer.hpp"
+#include "vfs.hpp"
+#include "trace.hpp"
+#include "external/dr_mp3.h"    // bundled and compiled into raylib
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+// Current, fading out and prefetched tracks
+static const int DECK_COUNT = 3;
+// Frames per raylib stream buffer and per decode step
+static const int STREAM_FRAMES = 4096;
+static const int DECODE_FRAMES = 1024;
+// Two seconds of stereo audio at 48 kHz
+static const size_t RING_SAMPLES = 48000 * 2 * 2;
+
+struct MusicManager::Deck {
+    std::atomic<int> state{DECK_IDLE};
+    int trackId = -1;
+    std::string fileName;          // set by the game thread before handing the deck over
+    std::atomic<unsigned int> sampleRate{0};
+    drmp3 decoder;                 // decode thread only
+    bool decoderOpen = false;      // decode thread only; a deck closed while opening never had one
+    SampleRing ring{RING_SAMPLES}; // interleaved stereo
+
+    // Game thread only
+    AudioStream output = {};
+    bool started = false;
+    float volume = 1.0f;
+    float gain = 0.0f;
+    float targetGain = 0.0f;
+};
+
+MusicManager::MusicManager()
+{
+}
+
+MusicManager::~MusicManager()
+{
+    Unload();
+}
+
+void MusicManager::Init(float crossfadeSeconds)
+{
+    this->crossfadeSeconds = crossfadeSeconds;
+    SetAudioStreamBufferSizeDefault(STREAM_FRAMES);
+    for (int i = 0; i < DECK_COUNT; i++) {
+        decks.push_back(std::unique_ptr<Deck>(new Deck()));
+    }
+    running = true;
+    decodeThread = std::thread(&MusicManager::DecodeLoop, this);
+}
+
+void MusicManager::AddTrack(int trackId, const char* fileName, float volume)
+{
+    Track track;
+    track.id = trackId;
+    track.fileName = fileName;
+    track.volume = volume;
+    track.failed = false;
+    tracks.push_back(track);
+}
+
+MusicManager::Track* MusicManager::FindTrack(int trackId)
+{
+    for (auto& track : tracks) {
+        if (track.id == trackId) return &track;
+    }
+    return nullptr;
+}
+
+MusicManager::Deck* MusicManager::FindDeck(int trackId)
+{
+    for (auto& deck : decks) {
+        int state = deck->state.load();
+        if (deck->trackId == trackId && (state == DECK_OPENING || state == DECK_STREAMING)) return deck.get();
+    }
+    return nullptr;
+}
+
+MusicManager::Deck* MusicManager::OpenDeck(int trackId)
+{
+    Track* track = FindTrack(trackId);
+    if (track == nullptr || track->failed) return nullptr;
+
+    Deck* free = nullptr;
+    for (auto& deck : decks) {
+        if (deck->state.load() == DECK_IDLE) {
+            free = deck.get();
+            break;
+        }
+    }
+    if (free == nullptr) {
+        // Make room by dropping a deck that is open but silent (an unused prefetch); the slot is
+        // free again once the decode thread has closed it, and callers retry next frame
+        for (auto& deck : decks) {
+            if (deck.get() != current && deck->state.load() == DECK_STREAMING && deck->targetGain == 0.0f && !deck->started) {
+                CloseDeck(deck.get());
+                break;
+            }
+        }
+        return nullptr;
+    }
+
+    free->trackId = trackId;
+    free->fileName = track->fileName;
+    free->volume = track->volume;
+    free->gain = 0.0f;
+    free->targetGain = 0.0f;
+    free->started = false;
+    free->state.store(DECK_OPENING, std::memory_order_release);
+    return free;
+}
+
+void MusicManager::CloseDeck(Deck* deck)
+{
+    if (deck->output.buffer != NULL) {
+        StopAudioStream(deck->output);
+        UnloadAudioStream(deck->output);
+        deck->output = AudioStream{};
+    }
+    deck->started = false;
+    deck->targetGain = 0.0f;
+    if (deck == current) current = nullptr;
+    int state = deck->state.load();
+    if (state == DECK_OPENING || state == DECK_STREAMING) {
+        deck->state.store(DECK_CLOSING, std::memory_order_release);
+    }
+}
+
+void MusicManager::Play(int trackId)
+{
+    if (current != nullptr && current->trackId == trackId) {
+        if (paused) {
+            if (current->started) ResumeAudioStream(current->output);
+            paused = false;
+        }
+        return;
+    }
+
+    Deck* deck = FindDeck(trackId);
+    if (deck == nullptr) deck = OpenDeck(trackId);
+    if (deck == nullptr) return;
+
+    // Crossfade: the old track fades out while the new one fades in
+    if (current != nullptr) current->targetGain = 0.0f;
+    current = deck;
+    current->targetGain = 1.0f;
+    paused = false;
+}
+
+void MusicManager::Prefetch(int trackId)
+{
+    if (FindDeck(trackId) != nullptr) return;
+    // Only use a free deck; a prefetch never evicts anything
+    for (auto& deck : decks) {
+        if (deck->state.load() == DECK_IDLE) {
+            OpenDeck(trackId);
+            return;
+        }
+    }
+}
+
+void MusicManager::Pause()
+{
+    if (paused) return;
+    paused = true;
+    for (auto& deck : decks) {
+        if (deck.get() == current) {
+            if (deck->started) PauseAudioStream(deck->output);
+        } else if (deck->started) {
+            CloseDeck(deck.get()); // a pause cuts any fade in progress
+        }
+    }
+}
+
+void MusicManager::Stop()
+{
+    if (current == nullptr) return;
+    current->targetGain = 0.0f;
+    current = nullptr;
+    paused = false;
+}
+
+void MusicManager::FeedDeck(Deck* deck)
+{
+    static float samples[STREAM_FRAMES * 2];
+
+    if (deck->output.buffer == NULL) {
+        deck->output = LoadAudioStream(deck->sampleRate.load(), 32, 2);
+    }
+    // Hold off until a full buffer is decoded so playback doesn't start with a gap
+    if (!deck->started) {
+        if (deck->ring.Available() < (size_t)STREAM_FRAMES * 2) return;
+        PlayAudioStream(deck->output);
+        deck->started = true;
+    }
+    while (IsAudioStreamProcessed(deck->output)) {
+        size_t got = deck->ring.Read(samples, STREAM_FRAMES * 2);
+        if (got < (size_t)STREAM_FRAMES * 2) {
+            memset(samples + got, 0, (STREAM_FRAMES * 2 - got) * sizeof(float)); // underrun plays silence
+        }
+        UpdateAudioStream(deck->output, samples, STREAM_FRAMES);
+    }
+}
+
+void MusicManager::Update(float dt)
+{
+    TRACE_ZONE("MusicManager::Update");
+    float step = (crossfadeSeconds > 0.0f) ? dt / crossfadeSeconds : 1.0f;
+
+    for (auto& owned : decks) {
+        Deck* deck = owned.get();
+        int state = deck->state.load(std::memory_order_acquire);
+
+        if (state == DECK_FAILED) {
+            TraceLog(LOG_WARNING, "MUSIC: Could not open '%s'", deck->fileName.c_str());
+            Track* track = FindTrack(deck->trackId);
+            if (track != nullptr) track->failed = true;
+            if (deck == current) current = nullptr;
+            deck->state.store(DECK_IDLE, std::memory_order_release);
+            continue;
+        }
+        if (state != DECK_STREAMING) continue;
+
+        bool audible = (deck == current) || deck->started;
+        if (!audible) continue; // prefetched: the decode thread keeps its ring topped up
+        if (paused && deck == current) continue;
+
+        if (deck->gain < deck->targetGain) deck->gain = fminf(deck->targetGain, deck->gain + step);
+        else if (deck->gain > deck->targetGain) deck->gain = fmaxf(deck->targetGain, deck->gain - step);
+
+        if (deck != current && deck->gain <= 0.0f) {
+            CloseDeck(deck); // faded out
+            continue;
+        }
+        FeedDeck(deck);
+        SetAudioStreamVolume(deck->output, deck->gain * deck->volume);
+    }
+}
+
+void MusicManager::Unload()
+{
+    for (auto& deck : decks) {
+        CloseDeck(deck.get());
+    }
+    if (running) {
+        running = false;
+        decodeThread.join(); // closes any decoder still open on its way out
+    }
+    decks.clear();
+    tracks.clear();
+    current = nullptr;
+}
+
+int MusicManager::GetOpenStreamCount() const
+{
+    int count = 0;
+    for (auto& deck : decks) {
+        if (deck->state.load() != DECK_IDLE) count++;
+    }
+    return count;
+}
+
+// Decode thread: opens and closes decoders on request and keeps every streaming deck's ring full
+void MusicManager::DecodeLoop()
+{
+    TraceSetThreadName("music decode");
+    float decoded[DECODE_FRAMES * 2];
+    float stereo[DECODE_FRAMES * 2];
+
+    while (running) {
+        bool busy = false;
+        for (auto& owned : decks) {
+            Deck* deck = owned.get();
+            int state = deck->state.load(std::memory_order_acquire);
+
+            if (state == DECK_OPENING) {
+                // The game thread may ask to close the deck while it is still opening
+                int expected = DECK_OPENING;
+                // Packed tracks decode straight from the mapped archive
+                size_t packedSize = 0;
+                const unsigned char* packed = GetPackedAsset(deck->fileName.c_str(), &packedSize);
+                bool opened = (packed != nullptr) ? drmp3_init_memory(&deck->decoder, packed, packedSize, NULL)
+                                                  : drmp3_init_file(&deck->decoder, deck->fileName.c_str(), NULL);
+                if (opened) {
+                    deck->decoderOpen = true;
+                    deck->sampleRate.store(deck->decoder.sampleRate);
+                    deck->state.compare_exchange_strong(expected, DECK_STREAMING, std::memory_order_acq_rel);
+                } else if (!deck->state.compare_exchange_strong(expected, DECK_FAILED, std::memory_order_acq_rel)) {
+                    deck->state.store(DECK_IDLE, std::memory_order_release); // closed before it ever opened
+                }
+                busy = true;
+            }
+            else if (state == DECK_STREAMING) {
+                while (deck->ring.Free() >= (size_t)DECODE_FRAMES * 2) {
+                    drmp3_uint64 frames = drmp3_read_pcm_frames_f32(&deck->decoder, DECODE_FRAMES, decoded);
+                    if (frames == 0) {
+                        drmp3_seek_to_pcm_frame(&deck->decoder, 0); // tracks loop
+                        break;
+                    }
+                    const float* out = decoded;
+                    if (deck->decoder.channels == 1) {
+                        for (drmp3_uint64 i = 0; i < frames; i++) {
+                            stereo[i * 2] = decoded[i];
+                            stereo[i * 2 + 1] = decoded[i];
+                        }
+                        out = stereo;
+                    }
+                    deck->ring.Write(out, (size_t)frames * 2);
+                    busy = true;
+                }
+            }
+            else if (state == DECK_CLOSING) {
+                if (deck->decoderOpen) {
+                    drmp3_uninit(&deck->decoder);
+                    deck->decoderOpen = false;
+                }
+                deck->ring.Reset();
+                deck->state.store(DECK_IDLE, std::memory_order_release);
+                busy = true;
+            }
+        }
+        if (!busy) std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+
+    for (auto& deck : decks) {
+        if (deck->decoderOpen) {
+            drmp3_uninit(&deck->decoder);
+            deck->decoderOpen = false;
+        }
+        deck->state.store(DECK_IDLE);
+    }
+}
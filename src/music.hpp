@@ -0,0 +1,62 @@
+#pragma once
+#include <raylib.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Plays music tracks decoded on a background thread. Each open track owns a deck: the decode thread
+// reads its MP3 into a lock-free ring and the game thread only copies ready samples into a raylib
+// audio stream, so file I/O and decoding never land in frame time. Switching tracks crossfades, and
+// a track can be prefetched so it starts without a gap. Decks are closed as soon as they go idle.
+class MusicManager {
+public:
+    MusicManager();
+    ~MusicManager();
+
+    void Init(float crossfadeSeconds);
+    void AddTrack(int trackId, const char* fileName, float volume);
+    void Play(int trackId);      // idempotent: call every frame; resumes the track if it was paused
+    void Prefetch(int trackId);  // open and pre-decode a track that is likely to play next
+    void Pause();
+    void Stop();                 // fades out the current track
+    void Update(float dt);       // feeds playing streams and advances crossfades, once per frame
+    void Unload();
+
+    int GetOpenStreamCount() const;
+
+private:
+    enum DeckState {
+        DECK_IDLE,               // free, owned by the game thread
+        DECK_OPENING,            // handed to the decode thread to open
+        DECK_STREAMING,          // decode thread fills the ring, game thread drains it
+        DECK_CLOSING,            // handed to the decode thread to close
+        DECK_FAILED              // open failed, game thread returns it to idle
+    };
+
+    struct Deck;
+
+    struct Track {
+        int id;
+        std::string fileName;
+        float volume;
+        bool failed;             // file could not be opened, don't retry every frame
+    };
+
+    std::vector<Track> tracks;
+    std::vector<std::unique_ptr<Deck>> decks;
+    Deck* current = nullptr;
+    bool paused = false;
+    float crossfadeSeconds = 1.0f;
+
+    std::thread decodeThread;
+    std::atomic<bool> running{false};
+
+    Track* FindTrack(int trackId);
+    Deck* FindDeck(int trackId);
+    Deck* OpenDeck(int trackId);
+    void CloseDeck(Deck* deck);
+    void FeedDeck(Deck* deck);
+    void DecodeLoop();
+};
@@ -0,0 +1,174 @@
+#include "pacing.hpp"
+#include <raylib.h>
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+// Sleep can overshoot by a scheduler tick, so the last stretch before a deadline is spun
+static const std::chrono::microseconds SPIN_MARGIN(1500);
+
+unsigned int GetPacingWindowFlags(PacingMode mode)
+{
+    return (mode == PacingMode::VSync) ? FLAG_VSYNC_HINT : 0;
+}
+
+FramePacer::FramePacer()
+{
+    mode = PacingMode::Fixed;
+    requestedFps = 60;
+    currentFps = 60;
+    refreshRate = 60;
+    historyCount = 0;
+    historyHead = 0;
+    overBudgetFrames = 0;
+    underBudgetFrames = 0;
+}
+
+void FramePacer::Init(PacingMode newMode, int targetFps)
+{
+    mode = newMode;
+    requestedFps = targetFps;
+    refreshRate = IsWindowReady() ? GetMonitorRefreshRate(GetCurrentMonitor()) : 0;
+    if (refreshRate <= 0) refreshRate = 60;
+
+    currentFps = (mode == PacingMode::Adaptive) ? refreshRate : requestedFps;
+
+    // raylib's own limiter is disabled; this class does the waiting
+    SetTargetFPS(0);
+    lastFrameEnd = Clock::now();
+    workStart = lastFrameEnd;
+    presented = lastFrameEnd;
+    deadline = lastFrameEnd;
+    TraceLog(LOG_INFO, "PACING: Mode %s, target %d fps (monitor %d Hz)", PacingModeName(mode), currentFps, refreshRate);
+}
+
+void FramePacer::WaitUntil(Clock::time_point target) const
+{
+    Clock::time_point now = Clock::now();
+    if (target - now > SPIN_MARGIN) {
+        std::this_thread::sleep_for(target - now - SPIN_MARGIN);
+    }
+    while (Clock::now() < target) {
+        std::this_thread::yield();
+    }
+}
+
+void FramePacer::AdaptTarget(float workMs)
+{
+    // Drop to the next refresh divisor after a run of missed frames, climb back when there is headroom
+    float budgetMs = 1000.0f / currentFps;
+    if (workMs > budgetMs * 0.95f) {
+        overBudgetFrames++;
+        underBudgetFrames = 0;
+    } else if (workMs < budgetMs * 0.5f) {
+        underBudgetFrames++;
+        overBudgetFrames = 0;
+    } else {
+        overBudgetFrames = 0;
+        underBudgetFrames = 0;
+    }
+
+    if (overBudgetFrames >= 30 && currentFps > refreshRate / 4) {
+        currentFps /= 2;
+        overBudgetFrames = 0;
+        TraceLog(LOG_INFO, "PACING: Adaptive target lowered to %d fps", currentFps);
+    } else if (underBudgetFrames >= 240 && currentFps < refreshRate) {
+        currentFps = std::min(currentFps * 2, refreshRate);
+        underBudgetFrames = 0;
+        TraceLog(LOG_INFO, "PACING: Adaptive target raised to %d fps", currentFps);
+    }
+}
+
+void FramePacer::WaitForDeadline()
+{
+    if (mode != PacingMode::Fixed && mode != PacingMode::Adaptive) return;
+
+    Clock::time_point now = Clock::now();
+    if (mode == PacingMode::Adaptive) {
+        AdaptTarget(std::chrono::duration<float, std::milli>(now - workStart).count());
+    }
+    auto period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / currentFps));
+    deadline += period;
+    if (deadline < now) {
+        // Fell behind; restart the schedule instead of rushing to catch up
+        deadline = now;
+    } else {
+        WaitUntil(deadline);
+    }
+}
+
+void FramePacer::WaitForPresent()
+{
+#ifndef GAME_CUSTOM_FRAME_CONTROL
+    // EndDrawing swaps and then polls input, so this is the last point before the poll
+    WaitForDeadline();
+#endif
+    presented = Clock::now();
+}
+
+void FramePacer::EndFrame()
+{
+#ifdef GAME_CUSTOM_FRAME_CONTROL
+    // EndDrawing did neither; headless runs have no window to swap or poll
+    if (IsWindowReady()) SwapScreenBuffer();
+    presented = Clock::now();
+    WaitForDeadline();
+    if (IsWindowReady()) PollInputEvents();
+#endif
+    Clock::time_point now = Clock::now();
+    float frameMs = std::chrono::duration<float, std::milli>(now - lastFrameEnd).count();
+    float latencyMs = std::chrono::duration<float, std::milli>(presented - workStart).count();
+    lastFrameEnd = now;
+    workStart = now;
+
+    history[historyHead] = frameMs;
+    latencyHistory[historyHead] = latencyMs;
+    historyHead = (historyHead + 1) % HISTORY;
+    if (historyCount < HISTORY) historyCount++;
+}
+
+float FramePacer::GetFrameMs(int framesAgo) const
+{
+    if (framesAgo < 0 || framesAgo >= historyCount) return 0.0f;
+    int index = (historyHead - 1 - framesAgo + HISTORY) % HISTORY;
+    return history[index];
+}
+
+FrameStats FramePacer::GetStats() const
+{
+    FrameStats stats = {0, 0, 0, 0, 0, 0, 0, historyCount};
+    if (historyCount == 0) return stats;
+
+    float sorted[HISTORY];
+    double sum = 0.0;
+    double latencySum = 0.0;
+    for (int i = 0; i < historyCount; i++) {
+        sorted[i] = history[i];
+        sum += history[i];
+        latencySum += latencyHistory[i];
+        stats.maxLatencyMs = std::max(stats.maxLatencyMs, latencyHistory[i]);
+    }
+    stats.meanMs = (float)(sum / historyCount);
+    stats.latencyMs = (float)(latencySum / historyCount);
+
+    double variance = 0.0;
+    for (int i = 0; i < historyCount; i++) {
+        double d = history[i] - stats.meanMs;
+        variance += d * d;
+    }
+    stats.jitterMs = (float)std::sqrt(variance / historyCount);
+
+    std::sort(sorted, sorted + historyCount);
+    stats.minMs = sorted[0];
+    stats.maxMs = sorted[historyCount - 1];
+    stats.p99Ms = sorted[(int)((historyCount - 1) * 0.99f)];
+    return stats;
+}
+
+void FramePacer::Report() const
+{
+    FrameStats stats = GetStats();
+    TraceLog(LOG_INFO, "PACING: %s @ %d fps over %d frames: mean %.3f ms, jitter %.3f ms, min %.3f ms, p99 %.3f ms, max %.3f ms",
+             PacingModeName(mode), currentFps, stats.samples, stats.meanMs, stats.jitterMs, stats.minMs, stats.p99Ms, stats.maxMs);
+    TraceLog(LOG_INFO, "PACING: input poll to present: mean %.3f ms, max %.3f ms", stats.latencyMs, stats.maxLatencyMs);
+}
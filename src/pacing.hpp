@@ -0,0 +1,62 @@
+#pragma once
+#include "config.hpp"
+#include <chrono>
+
+// Frame-time statistics over the most recent frames, in milliseconds
+struct FrameStats {
+    float meanMs;
+    float jitterMs;   // standard deviation of frame time
+    float minMs;
+    float maxMs;
+    float p99Ms;
+    float latencyMs;      // mean time from polling input to presenting the frame built from it
+    float maxLatencyMs;
+    int samples;
+};
+
+// Paces the main loop according to a PacingMode and measures the resulting frame times.
+// Call GetPacingWindowFlags before InitWindow, Init after it, WaitForPresent right before
+// EndDrawing and EndFrame right after it.
+//
+// The wait has to come before input is polled, or every update runs on input a whole frame
+// period old. Stock raylib swaps and polls together inside EndDrawing, so the wait happens just
+// before it. With -DGAME_CUSTOM_FRAME_CONTROL (raylib built with SUPPORT_CUSTOM_FRAME_CONTROL)
+// EndFrame swaps, waits and then polls itself, which also keeps the wait out of the latency.
+class FramePacer {
+public:
+    static constexpr int HISTORY = 600;
+
+    FramePacer();
+    void Init(PacingMode mode, int targetFps);
+    void WaitForPresent();
+    void EndFrame();
+    FrameStats GetStats() const;
+    void Report() const;
+    PacingMode GetMode() const { return mode; }
+    int GetTarget() const { return currentFps; }
+    float GetFrameMs(int framesAgo) const;   // frame time history, 0 = latest
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    PacingMode mode;
+    int requestedFps;
+    int currentFps;
+    int refreshRate;
+    Clock::time_point deadline;
+    Clock::time_point lastFrameEnd;
+    Clock::time_point workStart;        // input was last polled
+    Clock::time_point presented;
+    float history[HISTORY];
+    float latencyHistory[HISTORY];
+    int historyCount;
+    int historyHead;
+    int overBudgetFrames;
+    int underBudgetFrames;
+
+    void WaitUntil(Clock::time_point target) const;
+    void WaitForDeadline();
+    void AdaptTarget(float workMs);
+};
+
+unsigned int GetPacingWindowFlags(PacingMode mode);
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// On-disk layout of the asset archive written by tools/assetpack.cpp and read by vfs.cpp:
+//
+//   PackHeader | PackSlot[slotCount] | path names | file data...
+//
+// The slot table is an open-addressed hash on the asset path (linear probing, at most half full),
+// so a lookup touches one or two slots. Every file starts on a PACK_ALIGNMENT boundary so the
+// mapped archive can be read in place. All integers are little-endian.
+
+static const uint32_t PACK_MAGIC = 0x4b415052;     // "RPAK"
+static const uint32_t PACK_VERSION = 1;
+static const uint64_t PACK_ALIGNMENT = 4096;
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slotCount;         // power of two
+    uint32_t entryCount;
+    uint64_t namesOffset;
+    uint64_t namesSize;
+};
+
+struct PackSlot {
+    uint64_t hash;              // 0 marks an empty slot
+    uint32_t nameOffset;        // into the names block, not terminated
+    uint32_t nameLength;
+    uint64_t offset;            // from the start of the archive
+    uint64_t size;
+};
+
+// FNV-1a over the path with '\' folded to '/', so both spellings find the same entry
+inline uint64_t HashPackPath(const char* path, size_t length)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)path[i];
+        if (c == '\\') c = '/';
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return (hash == 0) ? 1 : hash;
+}
+
+inline bool PackPathsEqual(const char* a, const char* b, size_t length)
+{
+    for (size_t i = 0; i < length; i++) {
+        char ca = (a[i] == '\\') ? '/' : a[i];
+        char cb = (b[i] == '\\') ? '/' : b[i];
+        if (ca != cb) return false;
+    }
+    return true;
+}
+
+inline uint64_t AlignPackOffset(uint64_t offset)
+{
+    return (offset + PACK_ALIGNMENT - 1) & ~(PACK_ALIGNMENT - 1);
+}
@@ -0,0 +1,196 @@
+#include "particles.hpp"
+#include "world.hpp"
+#include "render.hpp"
+#include "trace.hpp"
+#include <cmath>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PARTICLES_SSE 1
+#endif
+
+// Capacity is a multiple of the SIMD width so the integrate loop never needs a scalar tail
+static const int MAX_PARTICLES = 65536;
+
+// Structure of arrays: the update only touches the float streams it needs
+alignas(16) static float posX[MAX_PARTICLES];
+alignas(16) static float posY[MAX_PARTICLES];
+alignas(16) static float velX[MAX_PARTICLES];
+alignas(16) static float velY[MAX_PARTICLES];
+alignas(16) static float gravity[MAX_PARTICLES];
+alignas(16) static float life[MAX_PARTICLES];
+alignas(16) static float invLifetime[MAX_PARTICLES];
+alignas(16) static float fade[MAX_PARTICLES];
+alignas(16) static float halfSize[MAX_PARTICLES];
+static Color color[MAX_PARTICLES];
+
+// Draw scratch, filled with the visible particles each frame
+static Rectangle quadRects[MAX_PARTICLES];
+static Color quadColors[MAX_PARTICLES];
+
+static int particleCount = 0;
+static int particleBudget = 0;
+static uint32_t rngState = 0x9E3779B9u;
+
+static float RandomUnit()
+{
+    // xorshift32, good enough for visual jitter and much cheaper than GetRandomValue
+    rngState ^= rngState << 13;
+    rngState ^= rngState >> 17;
+    rngState ^= rngState << 5;
+    return (float)(rngState >> 8) * (1.0f / 16777216.0f);
+}
+
+void InitParticles(int budget)
+{
+    if (budget <= 0 || budget > MAX_PARTICLES) budget = MAX_PARTICLES;
+    particleBudget = budget;
+    particleCount = 0;
+    TraceLog(LOG_INFO, "PARTICLES: Pool ready (budget %i of %i)", particleBudget, MAX_PARTICLES);
+}
+
+void UnloadParticles()
+{
+    particleCount = 0;
+    particleBudget = 0;
+}
+
+void EmitParticles(const ParticleBurst& burst)
+{
+    int count = burst.count;
+
+    // Above half the budget every burst is scaled down linearly until nothing more fits
+    int softLimit = particleBudget / 2;
+    if (particleCount > softLimit) {
+        count = (int)((long long)count * (particleBudget - particleCount) / (particleBudget - softLimit));
+    }
+    if (count > particleBudget - particleCount) count = particleBudget - particleCount;
+    if (count <= 0) return;
+
+    for (int n = 0; n < count; n++) {
+        int i = particleCount++;
+        float angle = burst.direction + (RandomUnit() * 2.0f - 1.0f) * burst.spread;
+        float speed = burst.speed * (0.25f + 0.75f * RandomUnit());
+        float lifetime = burst.lifetime * (0.5f + 0.5f * RandomUnit());
+
+        posX[i] = burst.position.x;
+        posY[i] = burst.position.y;
+        velX[i] = cosf(angle) * speed;
+        velY[i] = sinf(angle) * speed;
+        gravity[i] = burst.gravity;
+        life[i] = lifetime;
+        invLifetime[i] = 1.0f / lifetime;
+        fade[i] = 1.0f;
+        halfSize[i] = burst.size * (0.5f + 0.5f * RandomUnit()) * 0.5f;
+        color[i] = burst.color;
+    }
+}
+
+void UpdateParticles(float dt)
+{
+    TRACE_ZONE("UpdateParticles");
+    if (particleCount == 0) return;
+
+    // Integrate and fade, four particles at a time. Slots past particleCount are stale but
+    // inside the arrays, so rounding the count up is harmless.
+    int padded = (particleCount + 3) & ~3;
+#ifdef PARTICLES_SSE
+    const __m128 step = _mm_set1_ps(dt);
+    const __m128 zero = _mm_setzero_ps();
+    for (int i = 0; i < padded; i += 4) {
+        __m128 vy = _mm_add_ps(_mm_load_ps(&velY[i]), _mm_mul_ps(_mm_load_ps(&gravity[i]), step));
+        _mm_store_ps(&velY[i], vy);
+        _mm_store_ps(&posX[i], _mm_add_ps(_mm_load_ps(&posX[i]), _mm_mul_ps(_mm_load_ps(&velX[i]), step)));
+        _mm_store_ps(&posY[i], _mm_add_ps(_mm_load_ps(&posY[i]), _mm_mul_ps(vy, step)));
+        __m128 remaining = _mm_sub_ps(_mm_load_ps(&life[i]), step);
+        _mm_store_ps(&life[i], remaining);
+        _mm_store_ps(&fade[i], _mm_max_ps(zero, _mm_mul_ps(remaining, _mm_load_ps(&invLifetime[i]))));
+    }
+#else
+    for (int i = 0; i < padded; i++) {
+        velY[i] += gravity[i] * dt;
+        posX[i] += velX[i] * dt;
+        posY[i] += velY[i] * dt;
+        life[i] -= dt;
+        fade[i] = fmaxf(0.0f, life[i] * invLifetime[i]);
+    }
+#endif
+
+    // Remove expired particles by moving the last live one into their slot
+    int i = 0;
+    while (i < particleCount) {
+        if (life[i] > 0.0f) {
+            i++;
+            continue;
+        }
+        int last = --particleCount;
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        gravity[i] = gravity[last];
+        life[i] = life[last];
+        invLifetime[i] = invLifetime[last];
+        fade[i] = fade[last];
+        halfSize[i] = halfSize[last];
+        color[i] = color[last];
+    }
+}
+
+void DrawParticles()
+{
+    TRACE_ZONE("DrawParticles");
+    if (particleCount == 0) return;
+
+    // Visible particles are gathered into quads and handed to the backend as one batch
+    Rectangle view = GetWorldView();
+    float right = view.x + view.width;
+    float bottom = view.y + view.height;
+    int visible = 0;
+    for (int i = 0; i < particleCount; i++) {
+        float x = posX[i];
+        float y = posY[i];
+        float h = halfSize[i];
+        if (x + h < view.x || x - h > right || y + h < view.y || y - h > bottom) continue;
+
+        Color c = color[i];
+        c.a = (unsigned char)(c.a * fade[i]);
+        quadRects[visible] = Rectangle{x - h, y - h, 2.0f * h, 2.0f * h};
+        quadColors[visible] = c;
+        visible++;
+    }
+    GetRenderBackend().DrawQuads(quadRects, quadColors, visible);
+}
+
+void ClearParticles()
+{
+    particleCount = 0;
+}
+
+int GetParticleCount()
+{
+    return particleCount;
+}
+
+int GetParticleBudget()
+{
+    return particleBudget;
+}
+
+static Vector2 BoxCentre(Rectangle box)
+{
+    return Vector2{box.x + box.width * 0.5f, box.y + box.height * 0.5f};
+}
+
+void EmitHitBurst(Rectangle target, Color color)
+{
+    ParticleBurst burst = {BoxCentre(target), 48, color, 420.0f, PI, 0.0f, 0.45f, 6.0f, 900.0f};
+    EmitParticles(burst);
+}
+
+void EmitDeathBurst(Rectangle target, Color color)
+{
+    ParticleBurst burst = {BoxCentre(target), 400, color, 520.0f, PI, -PI * 0.5f, 1.2f, 8.0f, 600.0f};
+    EmitParticles(burst);
+}
@@ -0,0 +1,30 @@
+#pragma once
+#include <raylib.h>
+
+// One burst of particles thrown from a point. Particles are plain coloured squares in world space.
+struct ParticleBurst {
+    Vector2 position;
+    int count;
+    Color color;
+    float speed;        // maximum launch speed in pixels per second
+    float spread;       // cone half-angle in radians around direction (PI for all directions)
+    float direction;    // launch angle in radians, 0 = right, -PI/2 = up
+    float lifetime;     // seconds, each particle gets between half and all of it
+    float size;         // side of the square in pixels
+    float gravity;      // downward acceleration, negative to float upwards
+};
+
+// Fixed-capacity pool shared by every emitter. Bursts are thinned out as the live count approaches
+// the budget and dropped once it is reached, so heavy scenes lose detail instead of frame time.
+void InitParticles(int budget);
+void UnloadParticles();
+void EmitParticles(const ParticleBurst& burst);
+void UpdateParticles(float dt);
+void DrawParticles();       // call inside the world-space camera pass
+void ClearParticles();
+int GetParticleCount();
+int GetParticleBudget();
+
+// Common effects centred on an entity's box
+void EmitHitBurst(Rectangle target, Color color);
+void EmitDeathBurst(Rectangle target, Color color);
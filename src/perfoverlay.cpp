@@ -0,0 +1,206 @@
+#include "perfoverlay.hpp"
+#include "render.hpp"
+#include "trace.hpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+using PerfClock = std::chrono::steady_clock;
+
+static const int GRAPH_FRAMES = 240;        // one bar per frame
+static const int HISTOGRAM_FRAMES = 600;    // rolling window of the histogram
+static const int HISTOGRAM_BINS = 34;       // 1 ms each, the last one collects everything slower
+static const float AVERAGE_WEIGHT = 1.0f / 30.0f;
+static const float GRAPH_MAX_MS = 50.0f;
+
+static const char* PHASE_NAMES[PERF_PHASE_COUNT] = {
+    "input", "cheats", "fighter", "enemies", "combat", "music", "background", "geometry", "entities", "hud"
+};
+static const char* COUNTER_NAMES[PERF_COUNTER_COUNT] = { "live enemies", "spears", "draw calls", "collision tests" };
+
+static bool visible = false;
+static bool frameOpen = false;
+static PerfClock::time_point frameStart;
+static PerfClock::time_point phaseStart;
+static int openPhase = -1;
+
+static double phaseMs[PERF_PHASE_COUNT];            // this frame
+static int counters[PERF_COUNTER_COUNT];            // this frame
+static int shownCounters[PERF_COUNTER_COUNT];       // last finished frame
+static float averagePhaseMs[PERF_PHASE_COUNT];
+static float averageOtherMs = 0.0f;
+static float averageWorkMs = 0.0f;
+
+static float frameHistory[HISTOGRAM_FRAMES];        // full frame times, newest at historyHead - 1
+static int historyHead = 0;
+static int historyCount = 0;
+static int histogram[HISTOGRAM_BINS];
+
+static std::vector<Rectangle> quads;
+static std::vector<Color> quadColors;
+
+static double MillisecondsSince(PerfClock::time_point start)
+{
+    return std::chrono::duration<double, std::milli>(PerfClock::now() - start).count();
+}
+
+static int HistogramBin(float ms)
+{
+    int bin = (int)ms;
+    return (bin < HISTOGRAM_BINS - 1) ? bin : HISTOGRAM_BINS - 1;
+}
+
+static Color FrameColor(float ms)
+{
+    if (ms <= 1000.0f / 60.0f + 0.5f) return GREEN;
+    if (ms <= 1000.0f / 30.0f + 0.5f) return YELLOW;
+    return RED;
+}
+
+void BeginPerfFrame(float lastFrameMs)
+{
+    if (lastFrameMs > 0.0f) {
+        if (historyCount == HISTOGRAM_FRAMES) {
+            histogram[HistogramBin(frameHistory[historyHead])]--;
+        } else {
+            historyCount++;
+        }
+        frameHistory[historyHead] = lastFrameMs;
+        histogram[HistogramBin(lastFrameMs)]++;
+        historyHead = (historyHead + 1) % HISTOGRAM_FRAMES;
+    }
+
+    for (int i = 0; i < PERF_PHASE_COUNT; i++) {
+        phaseMs[i] = 0.0;
+    }
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        counters[i] = 0;
+    }
+    frameStart = PerfClock::now();
+    frameOpen = true;
+    openPhase = -1;
+}
+
+void EndPerfFrame()
+{
+    if (!frameOpen) return;
+    EndPerfPhase();
+    frameOpen = false;
+
+    float workMs = (float)MillisecondsSince(frameStart);
+    float phasedMs = 0.0f;
+    for (int i = 0; i < PERF_PHASE_COUNT; i++) {
+        averagePhaseMs[i] += ((float)phaseMs[i] - averagePhaseMs[i]) * AVERAGE_WEIGHT;
+        phasedMs += (float)phaseMs[i];
+    }
+    averageOtherMs += (workMs - phasedMs - averageOtherMs) * AVERAGE_WEIGHT;
+    averageWorkMs += (workMs - averageWorkMs) * AVERAGE_WEIGHT;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        shownCounters[i] = counters[i];
+    }
+}
+
+void BeginPerfPhase(PerfPhase phase)
+{
+    EndPerfPhase();
+    openPhase = phase;
+    phaseStart = PerfClock::now();
+}
+
+void EndPerfPhase()
+{
+    if (openPhase < 0) return;
+    PerfClock::time_point now = PerfClock::now();
+    phaseMs[openPhase] += std::chrono::duration<double, std::milli>(now - phaseStart).count();
+    TraceRecord(PHASE_NAMES[openPhase], phaseStart, now);
+    openPhase = -1;
+}
+
+void CountPerf(PerfCounter counter, int amount)
+{
+    counters[counter] += amount;
+}
+
+void SetPerfOverlayVisible(bool show)
+{
+    visible = show;
+}
+
+void TogglePerfOverlay()
+{
+    visible = !visible;
+}
+
+bool IsPerfOverlayVisible()
+{
+    return visible;
+}
+
+void DrawPerfOverlay(int x, int y)
+{
+    RenderBackend& gfx = GetRenderBackend();
+    const int width = 2 * GRAPH_FRAMES + 40;
+    const int graphHeight = 100;
+    const int fontSize = 20;
+    const int line = 24;
+    int height = 40 + graphHeight + 20 + graphHeight + 20 + line * (PERF_PHASE_COUNT + 2) + 10 + line * PERF_COUNTER_COUNT + 20;
+    gfx.DrawRectangle(x, y, width, height, Color{0, 0, 0, 190});
+
+    char text[96];
+    float lastMs = (historyCount > 0) ? frameHistory[(historyHead - 1 + HISTOGRAM_FRAMES) % HISTOGRAM_FRAMES] : 0.0f;
+    snprintf(text, sizeof(text), "frame %.1f ms (%.0f fps)   work %.2f ms", lastMs, (lastMs > 0.0f) ? 1000.0f / lastMs : 0.0f, averageWorkMs);
+    gfx.DrawText(text, x + 20, y + 12, fontSize, RAYWHITE);
+
+    // Frame-time graph, newest on the right, with 60 and 30 fps guides
+    int left = x + 20;
+    int top = y + 40;
+    quads.clear();
+    quadColors.clear();
+    int graphFrames = (historyCount < GRAPH_FRAMES) ? historyCount : GRAPH_FRAMES;
+    for (int i = 0; i < graphFrames; i++) {
+        float ms = frameHistory[(historyHead - 1 - i + 2 * HISTOGRAM_FRAMES) % HISTOGRAM_FRAMES];
+        float barHeight = (ms < GRAPH_MAX_MS ? ms : GRAPH_MAX_MS) / GRAPH_MAX_MS * graphHeight;
+        quads.push_back(Rectangle{(float)(left + 2 * (GRAPH_FRAMES - 1 - i)), top + graphHeight - barHeight, 2.0f, barHeight});
+        quadColors.push_back(FrameColor(ms));
+    }
+    for (float guideMs : { 1000.0f / 60.0f, 1000.0f / 30.0f }) {
+        quads.push_back(Rectangle{(float)left, top + graphHeight - guideMs / GRAPH_MAX_MS * graphHeight, 2.0f * GRAPH_FRAMES, 1.0f});
+        quadColors.push_back(Color{255, 255, 255, 90});
+    }
+
+    // Histogram of the last HISTOGRAM_FRAMES frames in 1 ms bins
+    int histogramTop = top + graphHeight + 20;
+    int binWidth = (2 * GRAPH_FRAMES) / HISTOGRAM_BINS;
+    int tallest = 1;
+    for (int count : histogram) {
+        if (count > tallest) tallest = count;
+    }
+    for (int bin = 0; bin < HISTOGRAM_BINS; bin++) {
+        float barHeight = (float)histogram[bin] / tallest * graphHeight;
+        quads.push_back(Rectangle{(float)(left + bin * binWidth), histogramTop + graphHeight - barHeight, (float)(binWidth - 1), barHeight});
+        quadColors.push_back(FrameColor((float)bin));
+    }
+    gfx.DrawQuads(quads.data(), quadColors.data(), (int)quads.size());
+    gfx.DrawText("0", left, histogramTop + graphHeight + 2, 10, LIGHTGRAY);
+    gfx.DrawText("16", left + 16 * binWidth, histogramTop + graphHeight + 2, 10, LIGHTGRAY);
+    gfx.DrawText("33+ ms", left + (HISTOGRAM_BINS - 1) * binWidth, histogramTop + graphHeight + 2, 10, LIGHTGRAY);
+
+    // Phase averages with a bar scaled to the 60 fps budget
+    int row = histogramTop + graphHeight + 20;
+    float budgetMs = 1000.0f / 60.0f;
+    for (int phase = 0; phase <= PERF_PHASE_COUNT; phase++) {
+        const char* name = (phase < PERF_PHASE_COUNT) ? PHASE_NAMES[phase] : "other";
+        float ms = (phase < PERF_PHASE_COUNT) ? averagePhaseMs[phase] : averageOtherMs;
+        snprintf(text, sizeof(text), "%-11s %6.2f ms", name, ms);
+        gfx.DrawText(text, left, row, fontSize, LIGHTGRAY);
+        float barWidth = (ms < budgetMs ? ms : budgetMs) / budgetMs * 200.0f;
+        gfx.DrawRectangle(left + 260, row + 4, (int)barWidth + 1, fontSize - 8, SKYBLUE);
+        row += line;
+    }
+    row += line + 10;
+    for (int i = 0; i < PERF_COUNTER_COUNT; i++) {
+        snprintf(text, sizeof(text), "%-16s %d", COUNTER_NAMES[i], shownCounters[i]);
+        gfx.DrawText(text, left, row, fontSize, LIGHTGRAY);
+        row += line;
+    }
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include <raylib.h>
+
+// Where each frame's time goes, shown by the performance overlay (F3). The main loop marks the
+// phase it is in; time outside any phase shows up as "other". Counters are per frame and can be
+// bumped from anywhere on the main thread.
+enum PerfPhase {
+    PERF_INPUT,
+    PERF_CHEATS,
+    PERF_FIGHTER,
+    PERF_ENEMIES,
+    PERF_COMBAT,
+    PERF_MUSIC,
+    PERF_BACKGROUND,
+    PERF_GEOMETRY,
+    PERF_ENTITIES,
+    PERF_HUD,
+    PERF_PHASE_COUNT
+};
+
+enum PerfCounter {
+    PERF_LIVE_ENEMIES,
+    PERF_SPEARS,
+    PERF_DRAW_CALLS,
+    PERF_COLLISION_TESTS,
+    PERF_COUNTER_COUNT
+};
+
+// lastFrameMs is the full (paced) time of the frame that just ended
+void BeginPerfFrame(float lastFrameMs);
+void EndPerfFrame();                    // before the frame pacer waits; the rest is idle time
+void BeginPerfPhase(PerfPhase phase);   // ends the phase before it
+void EndPerfPhase();
+void CountPerf(PerfCounter counter, int amount = 1);
+
+void SetPerfOverlayVisible(bool visible);
+void TogglePerfOverlay();
+bool IsPerfOverlayVisible();
+void DrawPerfOverlay(int x, int y);     // layout coordinates, top-left corner of the panel
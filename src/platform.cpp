@@ -1,4 +1,7 @@
 #include "platform.hpp"
+#include "world.hpp"
+#include "render.hpp"
+#include "trace.hpp"
 
 Platform::Platform(float x, float y, float width, float height, bool isGround)
 {
@@ -6,7 +9,7 @@ Platform::Platform(float x, float y, float width, float height, bool isGround)
     ground = isGround;
 }
 
-void Platform::Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol)
+void Platform::Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol) const
 {
     Rectangle sourceRec = {
         (float)(tileCol * tileWidth),
@@ -18,7 +21,7 @@ void Platform::Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRo
     // Draw tiles to fill the platform width
     for (float x = rect.x; x < rect.x + rect.width; x += tileWidth) {
         Rectangle destRec = {x, rect.y, (float)tileWidth, rect.height};
-        DrawTexturePro(tileset, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
+        GetRenderBackend().DrawTexturePro(tileset, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
     }
 }
 
@@ -38,7 +41,7 @@ Wall::Wall(float x, float y, float width, float height, bool standable)
     standableTop = standable;
 }
 
-void Wall::Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol)
+void Wall::Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol) const
 {
     Rectangle sourceRec = {
         216.0f,
@@ -50,7 +53,7 @@ void Wall::Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, i
     // Tile the texture along the height of the wall
     for (float y = rect.y; y < rect.y + rect.height; y += tileHeight) {
         Rectangle destRec = {rect.x, y, rect.width, (float)tileHeight};
-        DrawTexturePro(tileset, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
+        GetRenderBackend().DrawTexturePro(tileset, sourceRec, destRec, {0, 0}, 0.0f, WHITE);
     }
 }
 
@@ -67,4 +70,102 @@ bool Wall::CanStandOnTop() const
 bool Wall::BlocksMovement() const
 {
     return true;
-}
\ No newline at end of file
+}
+
+LevelGeometryCache::LevelGeometryCache()
+{
+    target = {0};
+    valid = false;
+    baked = false;
+}
+
+void LevelGeometryCache::Rebuild(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, Texture2D tileset,
+                                 int tileWidth, int tileHeight, int tileRow, int tileCol,
+                                 int wallWidth, int wallHeight, int wallRow, int wallCol)
+{
+    TRACE_ZONE("LevelGeometryCache::Rebuild");
+    levelPlatforms = platforms;
+    levelWalls = walls;
+    this->tileset = tileset;
+    platformTile = {tileWidth, tileHeight, tileRow, tileCol};
+    wallTile = {wallWidth, wallHeight, wallRow, wallCol};
+
+    // Index everything so oversized levels can draw only what the camera sees
+    Rectangle world = GetWorldBounds();
+    grid.Reset(world);
+    for (int i = 0; i < (int)levelPlatforms.size(); i++) {
+        grid.Insert(i, levelPlatforms[i].GetRect());
+    }
+    for (int i = 0; i < (int)levelWalls.size(); i++) {
+        grid.Insert((int)levelPlatforms.size() + i, levelWalls[i].GetRect());
+    }
+
+    int width = (int)world.width;
+    int height = (int)world.height;
+    baked = (width <= MAX_BAKE_SIZE && height <= MAX_BAKE_SIZE);
+    if (!baked) {
+        Unload();
+        valid = true;
+        return;
+    }
+
+    RenderBackend& gfx = GetRenderBackend();
+    if (target.id == 0 || target.texture.width != width || target.texture.height != height) {
+        Unload();
+        target = gfx.LoadRenderTexture(width, height);
+    }
+
+    gfx.BeginTextureMode(target);
+    gfx.ClearBackground(BLANK);
+    for (auto& platform : levelPlatforms) {
+        platform.Draw(tileset, tileWidth, tileHeight, tileRow, tileCol);
+    }
+    for (auto& wall : levelWalls) {
+        wall.Draw(tileset, wallWidth, wallHeight, wallRow, wallCol);
+    }
+    gfx.EndTextureMode();
+    valid = true;
+}
+
+void LevelGeometryCache::Invalidate()
+{
+    valid = false;
+}
+
+bool LevelGeometryCache::IsValid() const
+{
+    return valid && (!baked || target.id != 0);
+}
+
+void LevelGeometryCache::Draw(Rectangle view)
+{
+    TRACE_ZONE("LevelGeometryCache::Draw");
+    if (!IsValid()) return;
+
+    if (baked) {
+        // Render textures are stored bottom-up, so flip the source vertically
+        Rectangle source = {0, 0, (float)target.texture.width, -(float)target.texture.height};
+        GetRenderBackend().DrawTextureRec(target.texture, source, {0, 0}, WHITE);
+        return;
+    }
+
+    // Level too large to bake: draw the tiles of the pieces overlapping the view
+    grid.Query(view, visible);
+    int platformCount = (int)levelPlatforms.size();
+    for (int id : visible) {
+        if (id < platformCount) {
+            levelPlatforms[id].Draw(tileset, platformTile.width, platformTile.height, platformTile.row, platformTile.col);
+        } else {
+            levelWalls[id - platformCount].Draw(tileset, wallTile.width, wallTile.height, wallTile.row, wallTile.col);
+        }
+    }
+}
+
+void LevelGeometryCache::Unload()
+{
+    if (target.id != 0) {
+        GetRenderBackend().UnloadRenderTexture(target);
+        target = {0};
+    }
+    valid = false;
+}
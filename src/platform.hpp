@@ -1,10 +1,12 @@
 #pragma once
 #include <raylib.h>
+#include <vector>
+#include "spatialgrid.hpp"
 
 class Platform {
 public:
     Platform(float x, float y, float width, float height, bool isGround = false);
-    void Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol);
+    void Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol) const;
     Rectangle GetRect() const;
     bool IsGround() const;
     
@@ -17,7 +19,7 @@ private:
 class Wall {
 public:
     Wall(float x, float y, float width, float height, bool standable = true);
-    void Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol);
+    void Draw(Texture2D tileset, int tileWidth, int tileHeight, int tileRow, int tileCol) const;
     Rectangle GetRect() const;
     bool CanStandOnTop() const;   // if true, treat top like a small platform
     bool BlocksMovement() const;  // always true for a wall
@@ -25,4 +27,40 @@ public:
 private:
     Rectangle rect;
     bool standableTop;
-};
\ No newline at end of file
+};
+
+// Static level geometry baked once into a render texture; a frame then costs one blit
+// instead of one draw per tile. Levels bigger than MAX_BAKE_SIZE are not baked and draw only
+// the pieces the camera sees. Rebuild on level change or window resize.
+class LevelGeometryCache {
+public:
+    static constexpr int MAX_BAKE_SIZE = 4096;
+
+    LevelGeometryCache();
+    void Rebuild(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, Texture2D tileset,
+                 int tileWidth, int tileHeight, int tileRow, int tileCol,
+                 int wallWidth, int wallHeight, int wallRow, int wallCol);
+    void Invalidate();
+    bool IsValid() const;
+    void Draw(Rectangle view);
+    void Unload();
+
+private:
+    struct TileInfo {
+        int width;
+        int height;
+        int row;
+        int col;
+    };
+
+    RenderTexture2D target;
+    bool valid;
+    bool baked;
+    std::vector<Platform> levelPlatforms;
+    std::vector<Wall> levelWalls;
+    Texture2D tileset;
+    TileInfo platformTile;
+    TileInfo wallTile;
+    SpatialGrid grid;
+    std::vector<int> visible;
+};
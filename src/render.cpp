@@ -0,0 +1,273 @@
+#include "render.hpp"
+#include "perfoverlay.hpp"
+#include <rlgl.h>
+#include <cstring>
+
+static const int QUAD_CHUNK = 1024;
+
+static RaylibRenderBackend raylibBackend;
+static RenderBackend* activeBackend = &raylibBackend;
+
+void SetRenderBackend(RenderBackend* backend)
+{
+    activeBackend = (backend != nullptr) ? backend : &raylibBackend;
+}
+
+RenderBackend& GetRenderBackend()
+{
+    return *activeBackend;
+}
+
+double GetGameTime()
+{
+    return activeBackend->GetTime();
+}
+
+float GetGameFrameTime()
+{
+    return activeBackend->GetFrameTime();
+}
+
+// Raylib backend
+
+void RaylibRenderBackend::BeginDrawing() { ::BeginDrawing(); }
+void RaylibRenderBackend::EndDrawing() { ::EndDrawing(); }
+void RaylibRenderBackend::ClearBackground(Color color) { CountPerf(PERF_DRAW_CALLS); ::ClearBackground(color); }
+void RaylibRenderBackend::BeginMode2D(Camera2D camera) { ::BeginMode2D(camera); }
+void RaylibRenderBackend::EndMode2D() { ::EndMode2D(); }
+void RaylibRenderBackend::BeginTextureMode(RenderTexture2D target) { ::BeginTextureMode(target); }
+void RaylibRenderBackend::EndTextureMode() { ::EndTextureMode(); }
+
+Texture2D RaylibRenderBackend::LoadTexture(const char* fileName) { return ::LoadTexture(fileName); }
+Texture2D RaylibRenderBackend::LoadTextureFromImage(Image image) { return ::LoadTextureFromImage(image); }
+void RaylibRenderBackend::UnloadTexture(Texture2D texture) { ::UnloadTexture(texture); }
+RenderTexture2D RaylibRenderBackend::LoadRenderTexture(int width, int height) { return ::LoadRenderTexture(width, height); }
+void RaylibRenderBackend::UnloadRenderTexture(RenderTexture2D target) { ::UnloadRenderTexture(target); }
+void RaylibRenderBackend::SetTextureFilter(Texture2D texture, int filter) { ::SetTextureFilter(texture, filter); }
+
+Font RaylibRenderBackend::LoadFontEx(const char* fileName, int fontSize, int* codepoints, int codepointCount)
+{
+    return ::LoadFontEx(fileName, fontSize, codepoints, codepointCount);
+}
+
+void RaylibRenderBackend::UnloadFont(Font font) { ::UnloadFont(font); }
+
+void RaylibRenderBackend::DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint)
+{
+    CountPerf(PERF_DRAW_CALLS);
+    ::DrawTexturePro(texture, source, dest, origin, rotation, tint);
+}
+
+void RaylibRenderBackend::DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint)
+{
+    CountPerf(PERF_DRAW_CALLS);
+    ::DrawTextureRec(texture, source, position, tint);
+}
+
+void RaylibRenderBackend::DrawRectangle(int x, int y, int width, int height, Color color) { CountPerf(PERF_DRAW_CALLS); ::DrawRectangle(x, y, width, height, color); }
+void RaylibRenderBackend::DrawRectangleLines(int x, int y, int width, int height, Color color) { CountPerf(PERF_DRAW_CALLS); ::DrawRectangleLines(x, y, width, height, color); }
+void RaylibRenderBackend::DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color) { CountPerf(PERF_DRAW_CALLS); ::DrawRectangleLinesEx(rec, lineThick, color); }
+
+void RaylibRenderBackend::DrawRectangleGradientEx(Rectangle rec, Color topLeft, Color bottomLeft, Color bottomRight, Color topRight)
+{
+    CountPerf(PERF_DRAW_CALLS);
+    ::DrawRectangleGradientEx(rec, topLeft, bottomLeft, bottomRight, topRight);
+}
+
+void RaylibRenderBackend::DrawCircle(int centerX, int centerY, float radius, Color color) { CountPerf(PERF_DRAW_CALLS); ::DrawCircle(centerX, centerY, radius, color); }
+void RaylibRenderBackend::DrawText(const char* text, int x, int y, int fontSize, Color color) { CountPerf(PERF_DRAW_CALLS); ::DrawText(text, x, y, fontSize, color); }
+
+void RaylibRenderBackend::DrawTextPro(Font font, const char* text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint)
+{
+    CountPerf(PERF_DRAW_CALLS);
+    ::DrawTextPro(font, text, position, origin, rotation, fontSize, spacing, tint);
+}
+
+void RaylibRenderBackend::DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint)
+{
+    CountPerf(PERF_DRAW_CALLS);
+    ::DrawTextCodepoint(font, codepoint, position, fontSize, tint);
+}
+
+void RaylibRenderBackend::DrawQuads(const Rectangle* rects, const Color* colors, int count)
+{
+    // All quads use rlgl's default white texture so they share one batch. They are submitted in
+    // chunks to let rlgl flush its vertex buffer between them.
+    CountPerf(PERF_DRAW_CALLS);
+    rlSetTexture(rlGetTextureIdDefault());
+    for (int start = 0; start < count; start += QUAD_CHUNK) {
+        int end = (start + QUAD_CHUNK < count) ? start + QUAD_CHUNK : count;
+        rlCheckRenderBatchLimit(4 * (end - start));
+        rlBegin(RL_QUADS);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        for (int i = start; i < end; i++) {
+            const Rectangle& r = rects[i];
+            Color c = colors[i];
+            rlColor4ub(c.r, c.g, c.b, c.a);
+            rlTexCoord2f(0.0f, 0.0f); rlVertex2f(r.x, r.y);
+            rlTexCoord2f(0.0f, 1.0f); rlVertex2f(r.x, r.y + r.height);
+            rlTexCoord2f(1.0f, 1.0f); rlVertex2f(r.x + r.width, r.y + r.height);
+            rlTexCoord2f(1.0f, 0.0f); rlVertex2f(r.x + r.width, r.y);
+        }
+        rlEnd();
+    }
+    rlSetTexture(0);
+}
+
+double RaylibRenderBackend::GetTime() { return ::GetTime(); }
+float RaylibRenderBackend::GetFrameTime() { return ::GetFrameTime(); }
+
+// Null backend
+
+NullRenderBackend::NullRenderBackend(float frameStep)
+{
+    memset(&stats, 0, sizeof(stats));
+    nextTextureId = 1;
+    this->frameStep = frameStep;
+    time = 0.0;
+}
+
+Texture2D NullRenderBackend::CreateTexture(int width, int height)
+{
+    Texture2D texture = {0};
+    if (width <= 0 || height <= 0) return texture;
+    texture.id = nextTextureId++;
+    texture.width = width;
+    texture.height = height;
+    texture.mipmaps = 1;
+    texture.format = PIXELFORMAT_UNCOMPRESSED_R8G8B8A8;
+
+    stats.textures++;
+    stats.textureBytes += (long long)width * height * 4;
+    if (stats.textures > stats.peakTextures) stats.peakTextures = stats.textures;
+    if (stats.textureBytes > stats.peakTextureBytes) stats.peakTextureBytes = stats.textureBytes;
+    return texture;
+}
+
+void NullRenderBackend::ReleaseTexture(Texture2D texture)
+{
+    if (texture.id == 0) return;
+    stats.textures--;
+    stats.textureBytes -= (long long)texture.width * texture.height * 4;
+}
+
+void NullRenderBackend::CountDraw(int vertexCount)
+{
+    CountPerf(PERF_DRAW_CALLS);
+    stats.drawCalls++;
+    stats.vertices += vertexCount;
+}
+
+void NullRenderBackend::BeginDrawing() {}
+
+void NullRenderBackend::EndDrawing()
+{
+    stats.frames++;
+    time += frameStep;
+}
+
+void NullRenderBackend::ClearBackground(Color color) { CountDraw(4); }
+void NullRenderBackend::BeginMode2D(Camera2D camera) {}
+void NullRenderBackend::EndMode2D() {}
+void NullRenderBackend::BeginTextureMode(RenderTexture2D target) {}
+void NullRenderBackend::EndTextureMode() {}
+
+Texture2D NullRenderBackend::LoadTexture(const char* fileName)
+{
+    // Decode the file anyway: its size is needed and the CPU cost belongs in the benchmark
+    Image image = LoadImage(fileName);
+    Texture2D texture = CreateTexture(image.width, image.height);
+    UnloadImage(image);
+    return texture;
+}
+
+Texture2D NullRenderBackend::LoadTextureFromImage(Image image)
+{
+    return CreateTexture(image.width, image.height);
+}
+
+void NullRenderBackend::UnloadTexture(Texture2D texture)
+{
+    ReleaseTexture(texture);
+}
+
+RenderTexture2D NullRenderBackend::LoadRenderTexture(int width, int height)
+{
+    RenderTexture2D target = {0};
+    target.texture = CreateTexture(width, height);
+    target.id = target.texture.id;
+    return target;
+}
+
+void NullRenderBackend::UnloadRenderTexture(RenderTexture2D target)
+{
+    ReleaseTexture(target.texture);
+}
+
+void NullRenderBackend::SetTextureFilter(Texture2D texture, int filter) {}
+
+Font NullRenderBackend::LoadFontEx(const char* fileName, int fontSize, int* codepoints, int codepointCount)
+{
+    // Same glyph data and atlas layout as raylib, minus the upload, so text measuring still works
+    Font font = {0};
+    int dataSize = 0;
+    unsigned char* data = LoadFileData(fileName, &dataSize);
+    if (data == NULL) return font;
+
+    font.baseSize = fontSize;
+    font.glyphCount = (codepointCount > 0) ? codepointCount : 95;
+    font.glyphPadding = 4;
+    font.glyphs = LoadFontData(data, dataSize, fontSize, codepoints, font.glyphCount, FONT_DEFAULT);
+    UnloadFileData(data);
+    if (font.glyphs != NULL) {
+        Image atlas = GenImageFontAtlas(font.glyphs, &font.recs, font.glyphCount, fontSize, font.glyphPadding, 0);
+        font.texture = CreateTexture(atlas.width, atlas.height);
+        UnloadImage(atlas);
+    }
+    return font;
+}
+
+void NullRenderBackend::UnloadFont(Font font)
+{
+    ReleaseTexture(font.texture);
+    if (font.glyphs != NULL) UnloadFontData(font.glyphs, font.glyphCount);
+    MemFree(font.recs);
+}
+
+void NullRenderBackend::DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) { CountDraw(4); }
+void NullRenderBackend::DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint) { CountDraw(4); }
+void NullRenderBackend::DrawRectangle(int x, int y, int width, int height, Color color) { CountDraw(4); }
+void NullRenderBackend::DrawRectangleLines(int x, int y, int width, int height, Color color) { CountDraw(8); }
+void NullRenderBackend::DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color) { CountDraw(16); }
+void NullRenderBackend::DrawRectangleGradientEx(Rectangle rec, Color topLeft, Color bottomLeft, Color bottomRight, Color topRight) { CountDraw(4); }
+void NullRenderBackend::DrawCircle(int centerX, int centerY, float radius, Color color) { CountDraw(36 * 3); }
+
+void NullRenderBackend::DrawText(const char* text, int x, int y, int fontSize, Color color)
+{
+    CountDraw(4 * (int)strlen(text));
+}
+
+void NullRenderBackend::DrawTextPro(Font font, const char* text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint)
+{
+    CountDraw(4 * (int)strlen(text));
+}
+
+void NullRenderBackend::DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint) { CountDraw(4); }
+
+void NullRenderBackend::DrawQuads(const Rectangle* rects, const Color* colors, int count)
+{
+    CountDraw(4 * count);
+}
+
+double NullRenderBackend::GetTime() { return time; }
+float NullRenderBackend::GetFrameTime() { return frameStep; }
+
+void NullRenderBackend::Report() const
+{
+    double frames = (stats.frames > 0) ? (double)stats.frames : 1.0;
+    TraceLog(LOG_INFO, "RENDER: %lld frames on the null backend", stats.frames);
+    TraceLog(LOG_INFO, "RENDER:     draw calls %.1f per frame, vertices %.1f per frame",
+        stats.drawCalls / frames, stats.vertices / frames);
+    TraceLog(LOG_INFO, "RENDER:     textures %i loaded (peak %i), %.1f MiB (peak %.1f MiB)",
+        stats.textures, stats.peakTextures, stats.textureBytes / 1048576.0, stats.peakTextureBytes / 1048576.0);
+}
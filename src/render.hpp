@@ -0,0 +1,149 @@
+#pragma once
+#include <raylib.h>
+
+// Everything the game draws or uploads goes through the active render backend, so the draw side
+// of the loop can run without a window. Method names mirror the raylib calls they replace.
+class RenderBackend {
+public:
+    virtual ~RenderBackend() {}
+
+    // Frame and render targets
+    virtual void BeginDrawing() = 0;
+    virtual void EndDrawing() = 0;
+    virtual void ClearBackground(Color color) = 0;
+    virtual void BeginMode2D(Camera2D camera) = 0;
+    virtual void EndMode2D() = 0;
+    virtual void BeginTextureMode(RenderTexture2D target) = 0;
+    virtual void EndTextureMode() = 0;
+
+    // GPU resources
+    virtual Texture2D LoadTexture(const char* fileName) = 0;
+    virtual Texture2D LoadTextureFromImage(Image image) = 0;
+    virtual void UnloadTexture(Texture2D texture) = 0;
+    virtual RenderTexture2D LoadRenderTexture(int width, int height) = 0;
+    virtual void UnloadRenderTexture(RenderTexture2D target) = 0;
+    virtual void SetTextureFilter(Texture2D texture, int filter) = 0;
+    virtual Font LoadFontEx(const char* fileName, int fontSize, int* codepoints, int codepointCount) = 0;
+    virtual void UnloadFont(Font font) = 0;
+
+    // Drawing
+    virtual void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) = 0;
+    virtual void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint) = 0;
+    virtual void DrawRectangle(int x, int y, int width, int height, Color color) = 0;
+    virtual void DrawRectangleLines(int x, int y, int width, int height, Color color) = 0;
+    virtual void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color) = 0;
+    virtual void DrawRectangleGradientEx(Rectangle rec, Color topLeft, Color bottomLeft, Color bottomRight, Color topRight) = 0;
+    virtual void DrawCircle(int centerX, int centerY, float radius, Color color) = 0;
+    virtual void DrawText(const char* text, int x, int y, int fontSize, Color color) = 0;
+    virtual void DrawTextPro(Font font, const char* text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint) = 0;
+    virtual void DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint) = 0;
+    // Untextured axis-aligned quads submitted as one batch
+    virtual void DrawQuads(const Rectangle* rects, const Color* colors, int count) = 0;
+
+    // Frame clock read by game logic in place of raylib's GetTime/GetFrameTime
+    virtual double GetTime() = 0;
+    virtual float GetFrameTime() = 0;
+
+    // Logs what the backend has seen so far (no-op for backends that do not count)
+    virtual void Report() const {}
+};
+
+// Forwards every call to raylib
+class RaylibRenderBackend : public RenderBackend {
+public:
+    void BeginDrawing() override;
+    void EndDrawing() override;
+    void ClearBackground(Color color) override;
+    void BeginMode2D(Camera2D camera) override;
+    void EndMode2D() override;
+    void BeginTextureMode(RenderTexture2D target) override;
+    void EndTextureMode() override;
+    Texture2D LoadTexture(const char* fileName) override;
+    Texture2D LoadTextureFromImage(Image image) override;
+    void UnloadTexture(Texture2D texture) override;
+    RenderTexture2D LoadRenderTexture(int width, int height) override;
+    void UnloadRenderTexture(RenderTexture2D target) override;
+    void SetTextureFilter(Texture2D texture, int filter) override;
+    Font LoadFontEx(const char* fileName, int fontSize, int* codepoints, int codepointCount) override;
+    void UnloadFont(Font font) override;
+    void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) override;
+    void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint) override;
+    void DrawRectangle(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleLines(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color) override;
+    void DrawRectangleGradientEx(Rectangle rec, Color topLeft, Color bottomLeft, Color bottomRight, Color topRight) override;
+    void DrawCircle(int centerX, int centerY, float radius, Color color) override;
+    void DrawText(const char* text, int x, int y, int fontSize, Color color) override;
+    void DrawTextPro(Font font, const char* text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint) override;
+    void DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint) override;
+    void DrawQuads(const Rectangle* rects, const Color* colors, int count) override;
+    double GetTime() override;
+    float GetFrameTime() override;
+};
+
+struct RenderStats {
+    long long frames;
+    long long drawCalls;
+    long long vertices;
+    int textures;               // currently loaded, render targets included
+    int peakTextures;
+    long long textureBytes;     // RGBA8 estimate of loaded textures
+    long long peakTextureBytes;
+};
+
+// Touches no GL and needs no window. Textures get fake ids (image files are still decoded for their
+// size), draws are only counted, and the clock advances a fixed step per frame.
+class NullRenderBackend : public RenderBackend {
+public:
+    explicit NullRenderBackend(float frameStep = 1.0f / 60.0f);
+
+    void BeginDrawing() override;
+    void EndDrawing() override;
+    void ClearBackground(Color color) override;
+    void BeginMode2D(Camera2D camera) override;
+    void EndMode2D() override;
+    void BeginTextureMode(RenderTexture2D target) override;
+    void EndTextureMode() override;
+    Texture2D LoadTexture(const char* fileName) override;
+    Texture2D LoadTextureFromImage(Image image) override;
+    void UnloadTexture(Texture2D texture) override;
+    RenderTexture2D LoadRenderTexture(int width, int height) override;
+    void UnloadRenderTexture(RenderTexture2D target) override;
+    void SetTextureFilter(Texture2D texture, int filter) override;
+    Font LoadFontEx(const char* fileName, int fontSize, int* codepoints, int codepointCount) override;
+    void UnloadFont(Font font) override;
+    void DrawTexturePro(Texture2D texture, Rectangle source, Rectangle dest, Vector2 origin, float rotation, Color tint) override;
+    void DrawTextureRec(Texture2D texture, Rectangle source, Vector2 position, Color tint) override;
+    void DrawRectangle(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleLines(int x, int y, int width, int height, Color color) override;
+    void DrawRectangleLinesEx(Rectangle rec, float lineThick, Color color) override;
+    void DrawRectangleGradientEx(Rectangle rec, Color topLeft, Color bottomLeft, Color bottomRight, Color topRight) override;
+    void DrawCircle(int centerX, int centerY, float radius, Color color) override;
+    void DrawText(const char* text, int x, int y, int fontSize, Color color) override;
+    void DrawTextPro(Font font, const char* text, Vector2 position, Vector2 origin, float rotation, float fontSize, float spacing, Color tint) override;
+    void DrawTextCodepoint(Font font, int codepoint, Vector2 position, float fontSize, Color tint) override;
+    void DrawQuads(const Rectangle* rects, const Color* colors, int count) override;
+    double GetTime() override;
+    float GetFrameTime() override;
+    void Report() const override;
+
+    const RenderStats& GetStats() const { return stats; }
+
+private:
+    Texture2D CreateTexture(int width, int height);
+    void ReleaseTexture(Texture2D texture);
+    void CountDraw(int vertexCount);
+
+    RenderStats stats;
+    unsigned int nextTextureId;
+    float frameStep;
+    double time;
+};
+
+// The backend starts as raylib; switch before loading any resource
+void SetRenderBackend(RenderBackend* backend);
+RenderBackend& GetRenderBackend();
+
+// Shorthands for the active backend's frame clock
+double GetGameTime();
+float GetGameFrameTime();
@@ -0,0 +1,126 @@
+#include "residency.hpp"
+#include "loader.hpp"
+#include <raylib.h>
+#include <cstring>
+#include <string>
+
+struct AssetSet {
+    int id;
+    std::string name;
+    std::vector<TextureAsset> textures;
+    std::vector<Texture2D> held;        // references taken while the set is active
+    long long peakBytes;
+};
+
+static std::vector<AssetSet> sets;
+static int activeSet = -1;
+static int prefetchedSet = -1;
+
+static AssetSet* FindSet(int setId)
+{
+    for (auto& set : sets) {
+        if (set.id == setId) return &set;
+    }
+    return nullptr;
+}
+
+static bool SetContains(const AssetSet* set, const char* fileName)
+{
+    if (set == nullptr) return false;
+    for (const auto& texture : set->textures) {
+        if (strcmp(texture.fileName, fileName) == 0) return true;
+    }
+    return false;
+}
+
+// Frees images decoded for a set the game did not move on to
+static void CancelPrefetch(const AssetSet* keep)
+{
+    AssetSet* stale = FindSet(prefetchedSet);
+    prefetchedSet = -1;
+    if (stale == nullptr || stale == keep) return;
+    for (const auto& texture : stale->textures) {
+        if (!SetContains(keep, texture.fileName)) {
+            CancelImageLoad(texture.fileName);
+        }
+    }
+}
+
+void DefineAssetSet(int setId, const char* name, const std::vector<TextureAsset>& textures)
+{
+    AssetSet* set = FindSet(setId);
+    if (set == nullptr) {
+        sets.emplace_back();
+        set = &sets.back();
+        set->id = setId;
+        set->peakBytes = 0;
+    }
+    set->name = name;
+    set->textures = textures;
+}
+
+void PrefetchAssetSet(int setId)
+{
+    AssetSet* set = FindSet(setId);
+    if (set == nullptr || setId == prefetchedSet) return;
+    CancelPrefetch(set);
+
+    for (const auto& texture : set->textures) {
+        if (!IsAssetResident(texture)) {
+            QueueImageLoad(texture.fileName);
+        }
+    }
+    prefetchedSet = setId;
+}
+
+void ActivateAssetSet(int setId)
+{
+    AssetSet* set = FindSet(setId);
+    if (set == nullptr || setId == activeSet) return;
+    if (prefetchedSet != setId) CancelPrefetch(set);
+    else prefetchedSet = -1;
+
+    // Take the new references first so textures both states share are never reloaded
+    for (const auto& texture : set->textures) {
+        set->held.push_back(AcquireAsset(texture));
+    }
+    AssetSet* previous = FindSet(activeSet);
+    if (previous != nullptr) {
+        for (Texture2D texture : previous->held) {
+            ReleaseTexture(texture);
+        }
+        previous->held.clear();
+    }
+    activeSet = setId;
+
+    long long bytes = GetResidentTextureBytes();
+    if (bytes > set->peakBytes) set->peakBytes = bytes;
+    TraceLog(LOG_INFO, "RESIDENCY: Entered '%s': %i textures resident, %.2f MiB", set->name.c_str(),
+             GetResidentTextureCount(), bytes / 1048576.0);
+}
+
+void ReleaseAssetSets()
+{
+    CancelPrefetch(nullptr);
+    AssetSet* active = FindSet(activeSet);
+    if (active != nullptr) {
+        for (Texture2D texture : active->held) {
+            ReleaseTexture(texture);
+        }
+        active->held.clear();
+    }
+    activeSet = -1;
+}
+
+int GetActiveAssetSet()
+{
+    return activeSet;
+}
+
+void ReportAssetSets()
+{
+    for (const auto& set : sets) {
+        TraceLog(LOG_INFO, "RESIDENCY: %-8s %2i textures, peak %.2f MiB resident", set.name.c_str(),
+                 (int)set.textures.size(), set.peakBytes / 1048576.0);
+    }
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include "textures.hpp"
+#include <vector>
+
+// Textures a game state needs resident. Activating a set takes references on its textures and
+// then drops the previous set's, so only what the old state alone used is evicted. Prefetching
+// decodes a set's missing images on the loader threads while the current state plays, leaving
+// just the GPU upload for the transition.
+void DefineAssetSet(int setId, const char* name, const std::vector<TextureAsset>& textures);
+void PrefetchAssetSet(int setId);
+void ActivateAssetSet(int setId);
+void ReleaseAssetSets();                // drops the active set's references (before the window closes)
+
+int GetActiveAssetSet();                // -1 before the first activation
+void ReportAssetSets();                 // peak resident texture memory seen in each set
@@ -0,0 +1,60 @@
+#include "ringbuffer.hpp"
+#include <algorithm>
+#include <cstring>
+
+SampleRing::SampleRing(size_t capacity)
+{
+    size_t size = 1;
+    while (size < capacity) size <<= 1;
+    buffer.assign(size, 0.0f);
+    mask = size - 1;
+    written.store(0);
+    consumed.store(0);
+}
+
+size_t SampleRing::Write(const float* samples, size_t count)
+{
+    size_t head = written.load(std::memory_order_relaxed);
+    size_t tail = consumed.load(std::memory_order_acquire);
+    count = std::min(count, buffer.size() - (head - tail));
+
+    // Copy in at most two pieces around the wrap point
+    size_t start = head & mask;
+    size_t first = std::min(count, buffer.size() - start);
+    memcpy(&buffer[start], samples, first * sizeof(float));
+    memcpy(&buffer[0], samples + first, (count - first) * sizeof(float));
+
+    written.store(head + count, std::memory_order_release);
+    return count;
+}
+
+size_t SampleRing::Read(float* out, size_t count)
+{
+    size_t tail = consumed.load(std::memory_order_relaxed);
+    size_t head = written.load(std::memory_order_acquire);
+    count = std::min(count, head - tail);
+
+    size_t start = tail & mask;
+    size_t first = std::min(count, buffer.size() - start);
+    memcpy(out, &buffer[start], first * sizeof(float));
+    memcpy(out + first, &buffer[0], (count - first) * sizeof(float));
+
+    consumed.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+size_t SampleRing::Available() const
+{
+    return written.load(std::memory_order_acquire) - consumed.load(std::memory_order_acquire);
+}
+
+size_t SampleRing::Free() const
+{
+    return buffer.size() - Available();
+}
+
+void SampleRing::Reset()
+{
+    written.store(0);
+    consumed.store(0);
+}
@@ -0,0 +1,23 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Lock-free single-producer single-consumer ring of samples. One thread only writes and one thread
+// only reads; neither side ever waits, a full or empty ring just returns a short count.
+class SampleRing {
+public:
+    explicit SampleRing(size_t capacity);   // rounded up to a power of two
+
+    size_t Write(const float* samples, size_t count);
+    size_t Read(float* out, size_t count);
+    size_t Available() const;               // samples ready to read
+    size_t Free() const;                    // samples that can be written
+    void Reset();                           // only while neither side is using the ring
+
+private:
+    std::vector<float> buffer;
+    size_t mask;
+    std::atomic<size_t> written;            // total samples ever written, owned by the producer
+    std::atomic<size_t> consumed;           // total samples ever read, owned by the consumer
+};
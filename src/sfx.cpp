@@ -0,0 +1,238 @@
+#include "sfx.hpp"
+#include "vfs.hpp"
+#include "loadtimes.hpp"
+#include "trace.hpp"
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+
+// Aliases per clip: how many copies of one clip can overlap
+static const int ALIASES_PER_CLIP = 4;
+static const int MAX_VOICES = 32;
+static const int SYNTH_SAMPLE_RATE = 22050;
+
+struct SfxClipInfo {
+    const char* fileName;
+    int priority;           // higher wins when voices run out
+    float volume;
+    // Placeholder tone used when the file is missing: a pitch sweep mixed with noise
+    float startHz;
+    float endHz;
+    float noise;
+    float seconds;
+};
+
+static const SfxClipInfo manifest[SFX_COUNT] = {
+    { "resources/sfx/slash.wav",        1, 0.5f,  900.0f,  300.0f, 0.7f, 0.12f },   // SFX_SLASH
+    { "resources/sfx/hit.wav",          2, 0.6f,  220.0f,   80.0f, 0.5f, 0.10f },   // SFX_HIT
+    { "resources/sfx/enemy_death.wav",  3, 0.6f,  300.0f,   40.0f, 0.4f, 0.40f },   // SFX_ENEMY_DEATH
+    { "resources/sfx/player_death.wav", 5, 0.8f,  440.0f,   55.0f, 0.2f, 0.70f },   // SFX_PLAYER_DEATH
+    { "resources/sfx/spear_throw.wav",  1, 0.4f,  600.0f, 1200.0f, 0.6f, 0.15f },   // SFX_SPEAR_THROW
+    { "resources/sfx/spear_impact.wav", 2, 0.5f,  160.0f,   60.0f, 0.8f, 0.08f },   // SFX_SPEAR_IMPACT
+    { "resources/sfx/boss_cast.wav",    4, 0.7f,   80.0f,  500.0f, 0.3f, 0.80f },   // SFX_BOSS_CAST
+};
+
+struct SfxClip {
+    bool loaded;
+    Sound source;
+    Sound aliases[ALIASES_PER_CLIP];
+};
+
+struct SfxVoice {
+    int clip;               // -1 when free
+    int alias;
+    int priority;
+    unsigned int startFrame;
+};
+
+static SfxClip clips[SFX_COUNT];
+static SfxVoice voices[MAX_VOICES];
+static int voiceCount = 0;
+static bool pending[SFX_COUNT];
+static unsigned int frameCounter = 0;
+
+// Builds the placeholder clip so missing files still give audible feedback
+static Wave SynthesizeClip(const SfxClipInfo& info)
+{
+    Wave wave = {0};
+    wave.frameCount = (unsigned int)(info.seconds * SYNTH_SAMPLE_RATE);
+    wave.sampleRate = SYNTH_SAMPLE_RATE;
+    wave.sampleSize = 16;
+    wave.channels = 1;
+    short* samples = (short*)MemAlloc(wave.frameCount * sizeof(short));
+
+    uint32_t noiseState = 0x12345678u;
+    float phase = 0.0f;
+    for (unsigned int i = 0; i < wave.frameCount; i++) {
+        float t = (float)i / (float)wave.frameCount;
+        float hz = info.startHz + (info.endHz - info.startHz) * t;
+        phase += 2.0f * PI * hz / SYNTH_SAMPLE_RATE;
+        noiseState = noiseState * 1664525u + 1013904223u;
+        float noise = (float)(noiseState >> 8) / 8388608.0f - 1.0f;
+        float value = sinf(phase) * (1.0f - info.noise) + noise * info.noise;
+        float envelope = (1.0f - t) * (1.0f - t);
+        samples[i] = (short)(value * envelope * 30000.0f);
+    }
+    wave.data = samples;
+    return wave;
+}
+
+static void LoadClip(int id)
+{
+    const SfxClipInfo& info = manifest[id];
+    SfxClip& clip = clips[id];
+
+    LoadTimer timer(LOAD_DECODE, info.fileName);   // raylib decodes and fills the audio buffer in one call
+    if (AssetExists(info.fileName)) {
+        clip.source = LoadSound(info.fileName);
+    } else {
+        Wave wave = SynthesizeClip(info);
+        clip.source = LoadSoundFromWave(wave);
+        UnloadWave(wave);
+    }
+    timer.SetBytes((long long)clip.source.frameCount * clip.source.stream.channels * clip.source.stream.sampleSize / 8);
+    SetSoundVolume(clip.source, info.volume);
+    for (int i = 0; i < ALIASES_PER_CLIP; i++) {
+        clip.aliases[i] = LoadSoundAlias(clip.source);
+        SetSoundVolume(clip.aliases[i], info.volume);
+    }
+    clip.loaded = true;
+}
+
+static void UnloadClip(int id)
+{
+    SfxClip& clip = clips[id];
+    if (!clip.loaded) return;
+
+    for (int v = 0; v < voiceCount; v++) {
+        if (voices[v].clip == id) voices[v].clip = -1;
+    }
+    for (int i = 0; i < ALIASES_PER_CLIP; i++) {
+        StopSound(clip.aliases[i]);
+        UnloadSoundAlias(clip.aliases[i]);
+    }
+    UnloadSound(clip.source);
+    clip.loaded = false;
+}
+
+void InitSfx(int count)
+{
+    voiceCount = (count > 0 && count <= MAX_VOICES) ? count : MAX_VOICES;
+    for (int v = 0; v < MAX_VOICES; v++) {
+        voices[v].clip = -1;
+    }
+    for (int id = 0; id < SFX_COUNT; id++) {
+        clips[id].loaded = false;
+        pending[id] = false;
+    }
+}
+
+void LoadLevelSfx(const SfxId* wanted, int wantedCount)
+{
+    bool keep[SFX_COUNT] = {false};
+    for (int i = 0; i < wantedCount; i++) {
+        keep[wanted[i]] = true;
+    }
+    for (int id = 0; id < SFX_COUNT; id++) {
+        if (keep[id] && !clips[id].loaded) LoadClip(id);
+        else if (!keep[id] && clips[id].loaded) UnloadClip(id);
+    }
+}
+
+void PlaySfx(SfxId id)
+{
+    pending[id] = true;
+}
+
+// Returns a free voice, or steals the lowest-priority (then oldest) one if the new sound matters
+// at least as much. -1 means the trigger is dropped.
+static int AcquireVoice(int priority)
+{
+    int victim = -1;
+    for (int v = 0; v < voiceCount; v++) {
+        SfxVoice& voice = voices[v];
+        if (voice.clip < 0) return v;
+
+        if (voice.priority > priority) continue;
+        if (victim < 0 || voice.priority < voices[victim].priority ||
+            (voice.priority == voices[victim].priority && voice.startFrame < voices[victim].startFrame)) {
+            victim = v;
+        }
+    }
+    if (victim >= 0) {
+        StopSound(clips[voices[victim].clip].aliases[voices[victim].alias]);
+        voices[victim].clip = -1;
+    }
+    return victim;
+}
+
+// Picks an alias of the clip that no voice is using
+static int FreeAlias(int id)
+{
+    bool used[ALIASES_PER_CLIP] = {false};
+    for (int v = 0; v < voiceCount; v++) {
+        if (voices[v].clip == id) used[voices[v].alias] = true;
+    }
+    for (int i = 0; i < ALIASES_PER_CLIP; i++) {
+        if (!used[i]) return i;
+    }
+    return -1;
+}
+
+void UpdateSfx()
+{
+    TRACE_ZONE("UpdateSfx");
+    frameCounter++;
+
+    // Release voices whose sound has finished
+    for (int v = 0; v < voiceCount; v++) {
+        SfxVoice& voice = voices[v];
+        if (voice.clip >= 0 && !IsSoundPlaying(clips[voice.clip].aliases[voice.alias])) voice.clip = -1;
+    }
+
+    for (int id = 0; id < SFX_COUNT; id++) {
+        if (!pending[id]) continue;
+        pending[id] = false;
+        if (!clips[id].loaded) continue;
+
+        int priority = manifest[id].priority;
+        int alias = FreeAlias(id);
+        if (alias < 0) {
+            // Every copy of this clip is already playing: restart the oldest one instead
+            int oldest = -1;
+            for (int v = 0; v < voiceCount; v++) {
+                if (voices[v].clip == id && (oldest < 0 || voices[v].startFrame < voices[oldest].startFrame)) oldest = v;
+            }
+            if (oldest < 0) continue;
+            StopSound(clips[id].aliases[voices[oldest].alias]);
+            PlaySound(clips[id].aliases[voices[oldest].alias]);
+            voices[oldest].startFrame = frameCounter;
+            continue;
+        }
+
+        int v = AcquireVoice(priority);
+        if (v < 0) continue;
+        voices[v].clip = id;
+        voices[v].alias = alias;
+        voices[v].priority = priority;
+        voices[v].startFrame = frameCounter;
+        PlaySound(clips[id].aliases[alias]);
+    }
+}
+
+void UnloadSfx()
+{
+    for (int id = 0; id < SFX_COUNT; id++) {
+        UnloadClip(id);
+        pending[id] = false;
+    }
+}
+
+int GetActiveSfxVoices()
+{
+    int active = 0;
+    for (int v = 0; v < voiceCount; v++) {
+        if (voices[v].clip >= 0 && IsSoundPlaying(clips[voices[v].clip].aliases[voices[v].alias])) active++;
+    }
+    return active;
+}
@@ -0,0 +1,24 @@
+#pragma once
+#include <raylib.h>
+
+enum SfxId {
+    SFX_SLASH,
+    SFX_HIT,
+    SFX_ENEMY_DEATH,
+    SFX_PLAYER_DEATH,
+    SFX_SPEAR_THROW,
+    SFX_SPEAR_IMPACT,
+    SFX_BOSS_CAST,
+    SFX_COUNT
+};
+
+// Short combat sounds. Clips are decoded to PCM when a level loads, never during play. Triggers are
+// collected during the frame and each clip starts at most once per frame, on a voice from a fixed
+// pool; when the pool is full the quietest-priority, oldest voice is stolen (or the trigger dropped
+// if everything playing matters more), so mixing cost stays flat however many enemies get hit.
+void InitSfx(int voiceCount);
+void LoadLevelSfx(const SfxId* clips, int clipCount);   // decodes these, releases the rest
+void PlaySfx(SfxId id);
+void UpdateSfx();                                       // starts this frame's triggers, once per frame
+void UnloadSfx();
+int GetActiveSfxVoices();
@@ -1,5 +1,14 @@
 #include "slime.hpp"
 #include "fighter.hpp"
+#include "world.hpp"
+#include "particles.hpp"
+#include "sfx.hpp"
+#include "textures.hpp"
+#include "loadtimes.hpp"
+#include "tilemap.hpp"
+#include "perfoverlay.hpp"
+#include "render.hpp"
+#include "trace.hpp"
 #include <raylib.h>
 #include <cmath>
 
@@ -8,9 +17,12 @@ static AnimDef SLIME_DIE   = {2, 0, 6, 10};
 static AnimDef SLIME_IDLE  = {3, 0, 5, 10};  
 static AnimDef SLIME_HURT  = {4, 0, 3, 10}; 
 
+const TextureAsset Slime::SHEET = {"resources/enemies/slime/slime_spritesheet.png", 16, 16};
+
 Slime::Slime()
 {
-    atlas = LoadTexture("resources/enemies/slime/slime_spritesheet.png");
+    LoadTimer timer(LOAD_PHASE, "construct/Slime");
+    atlas = AcquireAsset(SHEET);
 
     textureWidth  = 16;
     textureHeight = 16;
@@ -27,7 +39,7 @@ Slime::Slime()
     hurtAnim = LoadAnim(SLIME_HURT, atlas, atlasInfo, false);
 
     // Place on ground 
-    position = { 600.0f, (float)GetScreenHeight() - 300.0f };
+    position = { 600.0f, GetWorldHeight() - 300.0f };
 
     scale  = 6.5f;
     width  = (int)(textureWidth  * scale);
@@ -53,12 +65,13 @@ Slime::Slime()
 
     state = State::Idle;
     lastState = State::Idle;
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
 }
 
 Slime::Slime(Vector2 startPos)
 {
-    atlas = LoadTexture("resources/enemies/slime/slime_spritesheet.png");
+    LoadTimer timer(LOAD_PHASE, "construct/Slime");
+    atlas = AcquireAsset(SHEET);
 
     textureWidth  = 16;
     textureHeight = 16;
@@ -101,7 +114,7 @@ Slime::Slime(Vector2 startPos)
 
     state = State::Idle;
     lastState = State::Idle;
-    animationStartTime = GetTime();
+    animationStartTime = GetGameTime();
 }
 
 Slime::~Slime()
@@ -110,14 +123,14 @@ Slime::~Slime()
     DisposeSpriteAnimation(walkAnim);
     DisposeSpriteAnimation(hurtAnim);
     DisposeSpriteAnimation(dieAnim);
-    UnloadTexture(atlas);
+    ReleaseTexture(atlas);
 }
 
 void Slime::SetState(State newState)
 {
     if (state != newState) {
         state = newState;
-        animationStartTime = GetTime();
+        animationStartTime = GetGameTime();
         lastState = newState;
     }
 }
@@ -132,8 +145,12 @@ void Slime::TakeDamage(float damageAmount)
         health = 0;
         isDying = true;
         SetState(State::Die);
+        EmitDeathBurst(GetHitbox(), Color{90, 200, 90, 255});
+        PlaySfx(SFX_ENEMY_DEATH);
     } else {
         SetState(State::Hurt);
+        EmitHitBurst(GetHitbox(), Color{90, 200, 90, 255});
+        PlaySfx(SFX_HIT);
         hurtTimer = 0.4f; // Hurt animation duration
     }
 }
@@ -144,7 +161,9 @@ Rectangle Slime::GetRect() const
 }
 Rectangle Slime::GetHitbox() const
 {
-    return Rectangle{ position.x, position.y, (float)width, (float)height };
+    // Follows the opaque bounds of the current animation frame
+    float elapsed = GetGameTime() - animationStartTime;
+    return GetSpriteAnimationBox(CurrentAnimation(), GetRect(), facingLeft, elapsed);
 }
 
 bool Slime::CheckPlatformCollision(const std::vector<Platform>& platforms)
@@ -153,7 +172,17 @@ bool Slime::CheckPlatformCollision(const std::vector<Platform>& platforms)
     bool grounded = false;
     standingOnGroundPlatform = false;
 
+    const TileMap* tiles = GetActiveTileMap();
+    TileSurface surface;
+    if (tiles != nullptr && speedY >= 0 && tiles->FindSurface(rect, isFallingThrough, surface)) {
+        position.y = surface.rect.y - height;
+        speedY = 0.0f;
+        standingOnGroundPlatform = surface.ground;
+        return true;
+    }
+
     for (const auto& platform : platforms) {
+        CountPerf(PERF_COLLISION_TESTS);
         Rectangle platformRect = platform.GetRect();
         
         // Skip collision if we're falling through platforms (but not ground)
@@ -185,9 +214,10 @@ bool Slime::CheckPlatformCollision(const std::vector<Platform>& platforms)
 
 void Slime::Update(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player)
 {
+    TRACE_ZONE("Slime::Update");
     const float GRAVITY = 800.0f;
     const float JUMP_VELOCITY = -600.0f;
-    float dt = GetFrameTime();
+    float dt = GetGameFrameTime();
 
     // Timers
     directionTimer -= dt;
@@ -216,7 +246,7 @@ void Slime::Update(const std::vector<Platform>& platforms, const std::vector<Wal
     // If dying, skip AI and only handle animation
     if (isDying) {
         float dieAnimDuration = (float)dieAnim.rectanglesCount / (float)dieAnim.framesPerSecond;
-        if (GetTime() - animationStartTime >= dieAnimDuration) {
+        if (GetGameTime() - animationStartTime >= dieAnimDuration) {
             // mark fully dead after death animation finishes
             isDeadFinal = true;
         }
@@ -230,9 +260,9 @@ void Slime::Update(const std::vector<Platform>& platforms, const std::vector<Wal
         position.y += speedY * dt;
         isOnGround = CheckPlatformCollision(platforms);
         
-        int screenH = GetScreenHeight();
-        if (position.y + height >= screenH) {
-            position.y = screenH - height;
+        float worldH = GetWorldHeight();
+        if (position.y + height >= worldH) {
+            position.y = worldH - height;
             speedY = 0.0f;
             isOnGround = true;
         }
@@ -246,14 +276,14 @@ void Slime::Update(const std::vector<Platform>& platforms, const std::vector<Wal
         facingLeft = (moveDir < 0);
         SetState(State::Walk);
 
-        // Clamp to screen bounds and flip if we hit edges
-        int screenW = GetScreenWidth();
+        // Clamp to world bounds and flip if we hit edges
+        float worldW = GetWorldWidth();
         if (position.x < 0.0f) {
             position.x = 0.0f;
             moveDir = 1;
             facingLeft = false;
-        } else if (position.x + width > screenW) {
-            position.x = (float)screenW - width;
+        } else if (position.x + width > worldW) {
+            position.x = worldW - width;
             moveDir = -1;
             facingLeft = true;
         }
@@ -332,10 +362,10 @@ void Slime::Update(const std::vector<Platform>& platforms, const std::vector<Wal
         isOnGround = false;
     }
 
-    // stick to bottom of screen
-    int screenH = GetScreenHeight();
-    if (position.y + height >= screenH) {
-        position.y = screenH - height;
+    // stick to bottom of the world
+    float worldH = GetWorldHeight();
+    if (position.y + height >= worldH) {
+        position.y = worldH - height;
         speedY = 0.0f;
         isOnGround = true;
         isFallingThrough = false; // Stop falling through when hitting screen bottom
@@ -345,22 +375,18 @@ void Slime::Update(const std::vector<Platform>& platforms, const std::vector<Wal
 
 void Slime::Draw()
 {
-    float elapsed = GetTime() - animationStartTime;
+    TRACE_ZONE("Slime::Draw");
+    float elapsed = GetGameTime() - animationStartTime;
     Vector2 origin{0,0};
-    Rectangle dest = GetRect();
+    DrawSpriteAnimationPro(CurrentAnimation(), GetRect(), origin, 0.0f, WHITE, facingLeft, elapsed);
+}
 
+const spriteAnimation& Slime::CurrentAnimation() const
+{
     switch (state) {
-        case State::Idle:
-            DrawSpriteAnimationPro(idleAnim, dest, origin, 0.0f, WHITE, facingLeft, elapsed);
-            break;
-        case State::Walk:
-            DrawSpriteAnimationPro(walkAnim, dest, origin, 0.0f, WHITE, facingLeft, elapsed);
-            break;
-        case State::Hurt:
-            DrawSpriteAnimationPro(hurtAnim, dest, origin, 0.0f, WHITE, facingLeft, elapsed);
-            break;
-        case State::Die:
-            DrawSpriteAnimationPro(dieAnim, dest, origin, 0.0f, WHITE, facingLeft, elapsed);
-            break;
+        case State::Walk: return walkAnim;
+        case State::Hurt: return hurtAnim;
+        case State::Die:  return dieAnim;
+        default:          return idleAnim;
     }
 }
@@ -4,6 +4,7 @@
 #include "platform.hpp"
 #include "animation.h"
 #include "enemy.hpp"
+#include "textures.hpp"
 
 // Forward declaration to avoid circular dependency
 class Fighter;
@@ -14,6 +15,8 @@ public:
     Slime(Vector2 startPos);
     virtual ~Slime() override;
 
+    static const TextureAsset SHEET;    // kept resident by the level asset sets
+
     // Override Enemy interface
     void Update(const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player) override;
     void Draw() override;
@@ -22,8 +25,11 @@ public:
     void TakeDamage(float damageAmount) override;
     bool IsDead() const override { return isDeadFinal; }
     float GetHealth() const override { return health; }
+    void RestoreHealth(float value) override { health = value; }
     
 private:
+    friend struct BenchAccess;  // tools/bench.cpp times the collision helpers directly
+
     // Textures & animations
     Texture2D atlas;
     AtlasInfo atlasInfo;
@@ -70,4 +76,5 @@ private:
     // Internals
     bool CheckPlatformCollision(const std::vector<Platform>& platforms);
     void SetState(State newState);
+    const spriteAnimation& CurrentAnimation() const;
 };
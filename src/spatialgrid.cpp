@@ -0,0 +1,82 @@
+#include "spatialgrid.hpp"
+#include <cmath>
+#include <algorithm>
+
+SpatialGrid::SpatialGrid(float cellSize) : cellSize(cellSize)
+{
+    bounds = {0, 0, 0, 0};
+    columns = 0;
+    rows = 0;
+    itemCount = 0;
+    queryStamp = 0;
+}
+
+void SpatialGrid::Reset(Rectangle newBounds)
+{
+    bounds = newBounds;
+    columns = (int)std::ceil(bounds.width / cellSize);
+    rows = (int)std::ceil(bounds.height / cellSize);
+    if (columns < 1) columns = 1;
+    if (rows < 1) rows = 1;
+    // Empty the cells but keep their storage; grids of moving items are rebuilt every frame
+    for (auto& cell : cells) {
+        cell.clear();
+    }
+    cells.resize(columns * rows);
+    seenStamp.clear();
+    itemCount = 0;
+    queryStamp = 0;
+}
+
+bool SpatialGrid::CellRange(Rectangle rect, int& minCol, int& minRow, int& maxCol, int& maxRow) const
+{
+    if (cells.empty()) return false;
+    minCol = (int)std::floor((rect.x - bounds.x) / cellSize);
+    minRow = (int)std::floor((rect.y - bounds.y) / cellSize);
+    maxCol = (int)std::floor((rect.x + rect.width - bounds.x) / cellSize);
+    maxRow = (int)std::floor((rect.y + rect.height - bounds.y) / cellSize);
+    if (maxCol < 0 || maxRow < 0 || minCol >= columns || minRow >= rows) return false;
+    if (minCol < 0) minCol = 0;
+    if (minRow < 0) minRow = 0;
+    if (maxCol >= columns) maxCol = columns - 1;
+    if (maxRow >= rows) maxRow = rows - 1;
+    return true;
+}
+
+void SpatialGrid::Insert(int id, Rectangle rect)
+{
+    int minCol, minRow, maxCol, maxRow;
+    if (!CellRange(rect, minCol, minRow, maxCol, maxRow)) return;
+    for (int row = minRow; row <= maxRow; row++) {
+        for (int col = minCol; col <= maxCol; col++) {
+            cells[row * columns + col].push_back(id);
+        }
+    }
+    if (id >= (int)seenStamp.size()) {
+        seenStamp.resize(id + 1, 0);
+    }
+    itemCount++;
+}
+
+void SpatialGrid::Query(Rectangle area, std::vector<int>& out) const
+{
+    out.clear();
+    int minCol, minRow, maxCol, maxRow;
+    if (!CellRange(area, minCol, minRow, maxCol, maxRow)) return;
+
+    queryStamp++;
+    if (queryStamp == 0) {
+        // Stamp wrapped around; clear so stale stamps cannot match
+        std::fill(seenStamp.begin(), seenStamp.end(), 0);
+        queryStamp = 1;
+    }
+    for (int row = minRow; row <= maxRow; row++) {
+        for (int col = minCol; col <= maxCol; col++) {
+            for (int id : cells[row * columns + col]) {
+                if (seenStamp[id] == queryStamp) continue;
+                seenStamp[id] = queryStamp;
+                out.push_back(id);
+            }
+        }
+    }
+}
@@ -0,0 +1,25 @@
+#pragma once
+#include <raylib.h>
+#include <vector>
+
+// Uniform grid over a world rectangle; answers "which items overlap this area" without a full scan
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 256.0f);
+    void Reset(Rectangle bounds);
+    void Insert(int id, Rectangle rect);
+    void Query(Rectangle area, std::vector<int>& out) const; // each id at most once
+    bool IsEmpty() const { return itemCount == 0; }
+
+private:
+    float cellSize;
+    Rectangle bounds;
+    int columns;
+    int rows;
+    int itemCount;
+    std::vector<std::vector<int>> cells;
+    mutable std::vector<unsigned int> seenStamp;  // per-id stamp used to dedupe query results
+    mutable unsigned int queryStamp;
+
+    bool CellRange(Rectangle rect, int& minCol, int& minRow, int& maxCol, int& maxRow) const;
+};
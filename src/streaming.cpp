@@ -0,0 +1,417 @@
+#include "streaming.hpp"
+#include "trace.hpp"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+// Chunk record in the cache file: counts, then platform, wall and enemy records
+struct ChunkHeader {
+    uint32_t platformCount;
+    uint32_t wallCount;
+    uint32_t enemyCount;
+};
+
+struct ChunkRect {
+    float x, y, width, height;
+    uint32_t flag;          // ground for platforms, standable top for walls
+};
+
+LevelStreamer::LevelStreamer()
+{
+}
+
+LevelStreamer::~LevelStreamer()
+{
+    End();
+}
+
+bool LevelStreamer::IsStreaming() const
+{
+    return level != nullptr;
+}
+
+int LevelStreamer::ChunkAt(float x) const
+{
+    int index = (int)floorf(x / chunkWidth);
+    if (index < 0) return 0;
+    if (index >= (int)chunks.size()) return (int)chunks.size() - 1;
+    return index;
+}
+
+bool LevelStreamer::Begin(LevelData& level, const char* cacheFile, float chunkWidth)
+{
+    End();
+    if (!level.tiles.IsEmpty() || chunkWidth <= 0.0f) return false;
+
+    file = fopen(cacheFile, "w+b");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "STREAM: Could not create cache '%s', level stays resident", cacheFile);
+        return false;
+    }
+    this->cacheFile = cacheFile;
+    this->chunkWidth = chunkWidth;
+    this->level = &level;
+    fileEnd = 0;
+
+    int count = (int)ceilf(level.width / chunkWidth);
+    chunks.assign(count < 1 ? 1 : count, Chunk{CHUNK_STORED, 0, 0, 0, false, 0, {}, {}, {}});
+
+    // Geometry spanning several chunks is cut at the boundaries; RebuildResident joins it again
+    for (const auto& platform : level.platforms) {
+        Rectangle r = platform.GetRect();
+        for (int i = ChunkAt(r.x); i <= ChunkAt(r.x + r.width - 0.01f); i++) {
+            float left = fmaxf(r.x, i * chunkWidth);
+            float right = fminf(r.x + r.width, (i + 1) * chunkWidth);
+            chunks[i].platforms.push_back(Platform(left, r.y, right - left, r.height, platform.IsGround()));
+        }
+    }
+    for (const auto& wall : level.walls) {
+        Rectangle r = wall.GetRect();
+        for (int i = ChunkAt(r.x); i <= ChunkAt(r.x + r.width - 0.01f); i++) {
+            float left = fmaxf(r.x, i * chunkWidth);
+            float right = fminf(r.x + r.width, (i + 1) * chunkWidth);
+            chunks[i].walls.push_back(Wall(left, r.y, right - left, r.height, wall.CanStandOnTop()));
+        }
+    }
+    for (const auto& spawn : level.spawns) {
+        Chunk& chunk = chunks[ChunkAt(spawn.position.x)];
+        chunk.enemies.push_back(ChunkEnemy{(uint32_t)spawn.kind, spawn.position.x, spawn.position.y, -1.0f});
+        chunk.aliveEnemies++;
+    }
+
+    // Write everything out and keep nothing; the I/O thread is not running yet
+    std::vector<unsigned char> data;
+    for (auto& chunk : chunks) {
+        Serialize(chunk, data);
+        chunk.offset = fileEnd;
+        chunk.size = chunk.capacity = (uint32_t)data.size();
+        fwrite(data.data(), 1, data.size(), file);
+        fileEnd += (long)data.size();
+        std::vector<Platform>().swap(chunk.platforms);
+        std::vector<Wall>().swap(chunk.walls);
+        std::vector<ChunkEnemy>().swap(chunk.enemies);
+    }
+    fflush(file);
+    std::vector<Platform>().swap(level.platforms);
+    std::vector<Wall>().swap(level.walls);
+    std::vector<EnemySpawn>().swap(level.spawns);
+
+    stopping = false;
+    ioThread = std::thread(&LevelStreamer::IoLoop, this);
+    TraceLog(LOG_INFO, "STREAM: %i chunks of %.0f px, %ld bytes in %s", (int)chunks.size(), chunkWidth, fileEnd, cacheFile);
+    return true;
+}
+
+void LevelStreamer::End()
+{
+    if (!IsStreaming()) return;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        stopping = true;
+        pending.clear();
+    }
+    ioReady.notify_all();
+    ioThread.join();
+    finished.clear();
+
+    fclose(file);
+    file = nullptr;
+    remove(cacheFile.c_str());
+    chunks.clear();
+    level = nullptr;
+}
+
+void LevelStreamer::IoLoop()
+{
+    TraceSetThreadName("level stream I/O");
+    for (;;) {
+        IoJob job;
+        {
+            std::unique_lock<std::mutex> lock(ioMutex);
+            ioReady.wait(lock, [this] { return stopping || !pending.empty(); });
+            if (pending.empty()) return;
+            job = std::move(pending.front());
+            pending.pop_front();
+        }
+
+        // Jobs run in order, so a read always sees the writes queued before it
+        fseek(file, job.offset, SEEK_SET);
+        if (job.write) {
+            fwrite(job.data.data(), 1, job.data.size(), file);
+        } else if (fread(job.data.data(), 1, job.data.size(), file) != job.data.size()) {
+            job.data.clear();
+        }
+
+        if (!job.write) {
+            std::lock_guard<std::mutex> lock(ioMutex);
+            finished.push_back(std::move(job));
+        }
+        ioDone.notify_all();
+    }
+}
+
+void LevelStreamer::QueueRead(int index)
+{
+    Chunk& chunk = chunks[index];
+    chunk.state = CHUNK_LOADING;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        pending.push_back(IoJob{false, index, chunk.offset, std::vector<unsigned char>(chunk.size)});
+    }
+    ioReady.notify_one();
+}
+
+void LevelStreamer::QueueWrite(int index)
+{
+    Chunk& chunk = chunks[index];
+    IoJob job = {true, index, 0, {}};
+    Serialize(chunk, job.data);
+    if (job.data.size() > chunk.capacity) {
+        chunk.offset = fileEnd;
+        chunk.capacity = (uint32_t)job.data.size();
+        fileEnd += (long)job.data.size();
+    }
+    chunk.size = (uint32_t)job.data.size();
+    chunk.dirty = false;
+    job.offset = chunk.offset;
+    {
+        std::lock_guard<std::mutex> lock(ioMutex);
+        pending.push_back(std::move(job));
+    }
+    ioReady.notify_one();
+}
+
+void LevelStreamer::CollectReads(int waitFor)
+{
+    std::deque<IoJob> reads;
+    {
+        std::unique_lock<std::mutex> lock(ioMutex);
+        if (waitFor >= 0) {
+            ioDone.wait(lock, [this, waitFor] {
+                for (const auto& job : finished) {
+                    if (job.chunk == waitFor) return true;
+                }
+                return false;
+            });
+        }
+        reads.swap(finished);
+    }
+
+    for (auto& job : reads) {
+        Chunk& chunk = chunks[job.chunk];
+        if (chunk.state != CHUNK_LOADING) continue;
+        if (!Deserialize(chunk, job.data)) {
+            // Leave it on disk untouched; Update reads it again while it is in range. Marking it
+            // loaded would activate an empty chunk and then write that back over the real one.
+            TraceLog(LOG_WARNING, "STREAM: Chunk %i could not be read back, retrying", job.chunk);
+            chunk.state = CHUNK_STORED;
+            continue;
+        }
+        chunk.state = CHUNK_LOADED;
+    }
+}
+
+void LevelStreamer::Serialize(const Chunk& chunk, std::vector<unsigned char>& data) const
+{
+    ChunkHeader header = { (uint32_t)chunk.platforms.size(), (uint32_t)chunk.walls.size(), (uint32_t)chunk.enemies.size() };
+    data.resize(sizeof(header) + (header.platformCount + header.wallCount) * sizeof(ChunkRect) + header.enemyCount * sizeof(ChunkEnemy));
+    unsigned char* cursor = data.data();
+    memcpy(cursor, &header, sizeof(header));
+    cursor += sizeof(header);
+    for (const auto& platform : chunk.platforms) {
+        Rectangle r = platform.GetRect();
+        ChunkRect record = { r.x, r.y, r.width, r.height, platform.IsGround() ? 1u : 0u };
+        memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+    }
+    for (const auto& wall : chunk.walls) {
+        Rectangle r = wall.GetRect();
+        ChunkRect record = { r.x, r.y, r.width, r.height, wall.CanStandOnTop() ? 1u : 0u };
+        memcpy(cursor, &record, sizeof(record));
+        cursor += sizeof(record);
+    }
+    if (!chunk.enemies.empty()) memcpy(cursor, chunk.enemies.data(), chunk.enemies.size() * sizeof(ChunkEnemy));
+}
+
+// Enemies already in the chunk (ones that walked in while it was on disk) are kept
+bool LevelStreamer::Deserialize(Chunk& chunk, const std::vector<unsigned char>& data) const
+{
+    ChunkHeader header;
+    if (data.size() < sizeof(header)) return false;
+    memcpy(&header, data.data(), sizeof(header));
+    if (data.size() != sizeof(header) + (header.platformCount + header.wallCount) * sizeof(ChunkRect) + header.enemyCount * sizeof(ChunkEnemy)) {
+        return false;
+    }
+
+    const unsigned char* cursor = data.data() + sizeof(header);
+    chunk.platforms.reserve(header.platformCount);
+    for (uint32_t i = 0; i < header.platformCount; i++, cursor += sizeof(ChunkRect)) {
+        ChunkRect record;
+        memcpy(&record, cursor, sizeof(record));
+        chunk.platforms.push_back(Platform(record.x, record.y, record.width, record.height, record.flag != 0));
+    }
+    chunk.walls.reserve(header.wallCount);
+    for (uint32_t i = 0; i < header.wallCount; i++, cursor += sizeof(ChunkRect)) {
+        ChunkRect record;
+        memcpy(&record, cursor, sizeof(record));
+        chunk.walls.push_back(Wall(record.x, record.y, record.width, record.height, record.flag != 0));
+    }
+    size_t arrived = chunk.enemies.size();
+    chunk.enemies.resize(arrived + header.enemyCount);
+    if (header.enemyCount > 0) memcpy(&chunk.enemies[arrived], cursor, header.enemyCount * sizeof(ChunkEnemy));
+    return true;
+}
+
+void LevelStreamer::Activate(int index, std::vector<Enemy*>& enemies)
+{
+    Chunk& chunk = chunks[index];
+    for (const auto& saved : chunk.enemies) {
+        Enemy* enemy = SpawnEnemy(EnemySpawn{(EnemyKind)saved.kind, {saved.x, saved.y}});
+        if (enemy == nullptr) continue;
+        if (saved.health >= 0.0f) enemy->RestoreHealth(saved.health);
+        enemies.push_back(enemy);
+    }
+    chunk.enemies.clear();
+    chunk.aliveEnemies = 0;
+    chunk.dirty = true;     // the cached copy no longer matches once its enemies are live
+    chunk.state = CHUNK_ACTIVE;
+}
+
+void LevelStreamer::StoreEnemy(int index, Enemy* enemy)
+{
+    Chunk& chunk = chunks[index];
+    // A dying enemy (health already at zero) is as good as dead; saving it would respawn a corpse
+    // that never finishes dying and holds up the all-enemies-defeated check
+    if (!enemy->IsDead() && enemy->GetHealth() > 0.0f) {
+        Rectangle r = enemy->GetRect();
+        chunk.enemies.push_back(ChunkEnemy{(uint32_t)GetEnemyKind(*enemy), r.x, r.y, enemy->GetHealth()});
+        chunk.aliveEnemies++;
+    }
+    chunk.dirty = true;
+    delete enemy;
+}
+
+void LevelStreamer::RebuildResident()
+{
+    level->platforms.clear();
+    level->walls.clear();
+    for (int i = 0; i < (int)chunks.size(); i++) {
+        if (chunks[i].state != CHUNK_ACTIVE) continue;
+        float edge = i * chunkWidth;
+        bool joinLeft = (i > 0 && chunks[i - 1].state == CHUNK_ACTIVE);
+
+        for (const auto& platform : chunks[i].platforms) {
+            Rectangle r = platform.GetRect();
+            bool joined = false;
+            for (size_t p = 0; joinLeft && r.x == edge && p < level->platforms.size() && !joined; p++) {
+                Rectangle q = level->platforms[p].GetRect();
+                if (q.x + q.width == edge && q.y == r.y && q.height == r.height && level->platforms[p].IsGround() == platform.IsGround()) {
+                    level->platforms[p] = Platform(q.x, q.y, q.width + r.width, q.height, platform.IsGround());
+                    joined = true;
+                }
+            }
+            if (!joined) level->platforms.push_back(platform);
+        }
+        for (const auto& wall : chunks[i].walls) {
+            Rectangle r = wall.GetRect();
+            bool joined = false;
+            for (size_t w = 0; joinLeft && r.x == edge && w < level->walls.size() && !joined; w++) {
+                Rectangle q = level->walls[w].GetRect();
+                if (q.x + q.width == edge && q.y == r.y && q.height == r.height && level->walls[w].CanStandOnTop() == wall.CanStandOnTop()) {
+                    level->walls[w] = Wall(q.x, q.y, q.width + r.width, q.height, wall.CanStandOnTop());
+                    joined = true;
+                }
+            }
+            if (!joined) level->walls.push_back(wall);
+        }
+    }
+}
+
+bool LevelStreamer::Update(Rectangle view, std::vector<Enemy*>& enemies)
+{
+    TRACE_ZONE("LevelStreamer::Update");
+    if (!IsStreaming()) return false;
+    CollectReads(-1);
+
+    int lastChunk = (int)chunks.size() - 1;
+    int firstActive = ChunkAt(view.x - chunkWidth);
+    int lastActive = ChunkAt(view.x + view.width + chunkWidth);
+    int firstLoaded = (firstActive > 0) ? firstActive - 1 : 0;
+    int lastLoaded = (lastActive < lastChunk) ? lastActive + 1 : lastChunk;
+    bool changed = false;
+
+    for (int i = 0; i <= lastChunk; i++) {
+        if (chunks[i].state == CHUNK_ACTIVE && (i < firstActive || i > lastActive)) {
+            chunks[i].state = CHUNK_LOADED;
+            changed = true;
+        }
+    }
+    for (int i = firstLoaded; i <= lastLoaded; i++) {
+        if (chunks[i].state == CHUNK_STORED) QueueRead(i);
+    }
+    for (int i = firstActive; i <= lastActive; i++) {
+        // Normally read ahead; a camera jump has to wait for the read
+        if (chunks[i].state == CHUNK_LOADING) CollectReads(i);
+        if (chunks[i].state == CHUNK_LOADED) {
+            Activate(i, enemies);
+            changed = true;
+        }
+    }
+
+    // Enemies outside the active chunks, including ones of chunks that just went idle, are saved
+    for (size_t e = 0; e < enemies.size(); ) {
+        Rectangle r = enemies[e]->GetRect();
+        int index = ChunkAt(r.x + r.width * 0.5f);
+        if (chunks[index].state == CHUNK_ACTIVE) {
+            e++;
+            continue;
+        }
+        StoreEnemy(index, enemies[e]);
+        enemies.erase(enemies.begin() + e);
+    }
+
+    for (int i = 0; i <= lastChunk; i++) {
+        Chunk& chunk = chunks[i];
+        if (chunk.state != CHUNK_LOADED || (i >= firstLoaded && i <= lastLoaded)) continue;
+        if (chunk.dirty) QueueWrite(i);
+        std::vector<Platform>().swap(chunk.platforms);
+        std::vector<Wall>().swap(chunk.walls);
+        std::vector<ChunkEnemy>().swap(chunk.enemies);
+        chunk.state = CHUNK_STORED;
+    }
+
+    if (changed) RebuildResident();
+    return changed;
+}
+
+int LevelStreamer::GetStreamedEnemyCount() const
+{
+    int count = 0;
+    for (const auto& chunk : chunks) {
+        count += chunk.aliveEnemies;
+    }
+    return count;
+}
+
+int LevelStreamer::GetActiveChunkCount() const
+{
+    int count = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk.state == CHUNK_ACTIVE) count++;
+    }
+    return count;
+}
+
+int LevelStreamer::GetLoadedChunkCount() const
+{
+    int count = 0;
+    for (const auto& chunk : chunks) {
+        if (chunk.state == CHUNK_ACTIVE || chunk.state == CHUNK_LOADED) count++;
+    }
+    return count;
+}
+
+int LevelStreamer::GetChunkCount() const
+{
+    return (int)chunks.size();
+}
@@ -0,0 +1,99 @@
+#pragma once
+#include <raylib.h>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "level.hpp"
+
+// Streams long levels in fixed-width chunks around the camera. Begin splits a level into chunks,
+// writes them to a cache file and keeps only the chunks near the view in memory: chunks within
+// one chunk of the view are active (their platforms and walls are in the level's lists and their
+// enemies are live), the next ones out are decoded but idle, and everything else lives only in
+// the file. Reads and writes run on an I/O thread. Enemies leaving the active chunks are written
+// back with their position and health and spawned again when their chunk comes back.
+//
+// Memory per level is the resident chunks plus one small record per chunk. Tile maps are not
+// chunked; levels with one are left unstreamed.
+class LevelStreamer {
+public:
+    LevelStreamer();
+    ~LevelStreamer();
+
+    // Takes over level's platforms, walls and spawns; returns false (leaving level alone) if the
+    // cache file cannot be created
+    bool Begin(LevelData& level, const char* cacheFile, float chunkWidth);
+    void End();
+    bool IsStreaming() const;
+
+    // Once per frame before the actors update. Adds and removes enemies in enemies as chunks
+    // activate and deactivate; returns true when the level's platform and wall lists changed.
+    bool Update(Rectangle view, std::vector<Enemy*>& enemies);
+
+    int GetStreamedEnemyCount() const;      // alive enemies in chunks that are not active
+    int GetActiveChunkCount() const;
+    int GetLoadedChunkCount() const;        // active plus decoded idle chunks
+    int GetChunkCount() const;
+
+private:
+    enum ChunkState {
+        CHUNK_STORED,       // only in the cache file
+        CHUNK_LOADING,      // read queued on the I/O thread
+        CHUNK_LOADED,       // decoded, idle
+        CHUNK_ACTIVE        // geometry in the level, enemies live
+    };
+
+    struct ChunkEnemy {
+        uint32_t kind;
+        float x, y;
+        float health;
+    };
+
+    struct Chunk {
+        ChunkState state;
+        long offset;
+        uint32_t size;
+        uint32_t capacity;  // bytes reserved in the file; a bigger rewrite moves to the end
+        bool dirty;         // enemies changed since the last write
+        int aliveEnemies;
+        std::vector<Platform> platforms;
+        std::vector<Wall> walls;
+        std::vector<ChunkEnemy> enemies;
+    };
+
+    struct IoJob {
+        bool write;
+        int chunk;
+        long offset;
+        std::vector<unsigned char> data;
+    };
+
+    LevelData* level = nullptr;
+    float chunkWidth = 0.0f;
+    std::string cacheFile;
+    FILE* file = nullptr;
+    long fileEnd = 0;
+    std::vector<Chunk> chunks;
+
+    std::thread ioThread;
+    std::mutex ioMutex;
+    std::condition_variable ioReady;
+    std::condition_variable ioDone;
+    std::deque<IoJob> pending;      // guarded by ioMutex
+    std::deque<IoJob> finished;     // reads handed back to the game thread, guarded by ioMutex
+    bool stopping = false;
+
+    void IoLoop();
+    void QueueRead(int index);
+    void QueueWrite(int index);
+    void CollectReads(int waitFor);
+    void Serialize(const Chunk& chunk, std::vector<unsigned char>& data) const;
+    bool Deserialize(Chunk& chunk, const std::vector<unsigned char>& data) const;
+    int ChunkAt(float x) const;
+    void Activate(int index, std::vector<Enemy*>& enemies);
+    void StoreEnemy(int index, Enemy* enemy);
+    void RebuildResident();
+};
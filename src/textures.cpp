@@ -0,0 +1,123 @@
+#include "textures.hpp"
+#include "animation.h"
+#include "loader.hpp"
+#include "render.hpp"
+#include <string>
+#include <vector>
+
+struct TextureEntry {
+    std::string fileName;
+    Texture2D texture;
+    bool trimmed;           // loaded through LoadTrimmedAtlas, unloaded through UnloadTrimmedAtlas
+    int frameWidth;         // frame size the atlas was trimmed with; 0 when untrimmed
+    int frameHeight;
+    int references;
+    long long bytes;
+};
+
+static std::vector<TextureEntry> entries;
+static long long residentBytes = 0;
+
+static TextureEntry* FindByPath(const char* fileName)
+{
+    for (auto& entry : entries) {
+        if (entry.fileName == fileName) return &entry;
+    }
+    return nullptr;
+}
+
+// The same file loaded plain and as a trimmed atlas, or trimmed with another frame size, gives a
+// different texture, so each combination is its own entry
+static TextureEntry* FindLoaded(const char* fileName, bool trimmed, int frameWidth, int frameHeight)
+{
+    for (auto& entry : entries) {
+        if (entry.fileName == fileName && entry.trimmed == trimmed &&
+            entry.frameWidth == frameWidth && entry.frameHeight == frameHeight) return &entry;
+    }
+    return nullptr;
+}
+
+static Texture2D Acquire(const char* fileName, bool trimmed, int frameWidth, int frameHeight)
+{
+    if (!trimmed) frameWidth = frameHeight = 0;
+    TextureEntry* entry = FindLoaded(fileName, trimmed, frameWidth, frameHeight);
+    if (entry != nullptr) {
+        entry->references++;
+        return entry->texture;
+    }
+
+    TextureEntry added;
+    added.fileName = fileName;
+    added.trimmed = trimmed;
+    added.frameWidth = frameWidth;
+    added.frameHeight = frameHeight;
+    added.texture = trimmed ? LoadTrimmedAtlas(fileName, frameWidth, frameHeight) : LoadTexturePreloaded(fileName);
+    added.references = 1;
+    added.bytes = (added.texture.id != 0) ? GetPixelDataSize(added.texture.width, added.texture.height, added.texture.format) : 0;
+    residentBytes += added.bytes;
+    entries.push_back(added);
+    return added.texture;
+}
+
+Texture2D AcquireTexture(const char* fileName)
+{
+    return Acquire(fileName, false, 0, 0);
+}
+
+Texture2D AcquireAtlas(const char* fileName, int frameWidth, int frameHeight)
+{
+    return Acquire(fileName, true, frameWidth, frameHeight);
+}
+
+Texture2D AcquireAsset(TextureAsset asset)
+{
+    bool trimmed = (asset.frameWidth > 0 && asset.frameHeight > 0);
+    return Acquire(asset.fileName, trimmed, asset.frameWidth, asset.frameHeight);
+}
+
+bool IsAssetResident(TextureAsset asset)
+{
+    bool trimmed = (asset.frameWidth > 0 && asset.frameHeight > 0);
+    return FindLoaded(asset.fileName, trimmed, trimmed ? asset.frameWidth : 0, trimmed ? asset.frameHeight : 0) != nullptr;
+}
+
+Texture2D FindTexture(const char* fileName)
+{
+    TextureEntry* entry = FindByPath(fileName);
+    return (entry != nullptr) ? entry->texture : Texture2D{0};
+}
+
+void ReleaseTexture(Texture2D texture)
+{
+    if (texture.id == 0) return;
+    for (auto it = entries.begin(); it != entries.end(); ++it) {
+        if (it->texture.id != texture.id) continue;
+        if (--it->references > 0) return;
+
+        if (it->trimmed) UnloadTrimmedAtlas(it->texture);
+        else GetRenderBackend().UnloadTexture(it->texture);
+        residentBytes -= it->bytes;
+        entries.erase(it);
+        return;
+    }
+    TraceLog(LOG_WARNING, "TEXTURES: Released texture %u that was never acquired", texture.id);
+}
+
+int GetResidentTextureCount()
+{
+    return (int)entries.size();
+}
+
+long long GetResidentTextureBytes()
+{
+    return residentBytes;
+}
+
+void LogResidentTextures()
+{
+    TraceLog(LOG_INFO, "TEXTURES: %i resident, %.2f MiB", (int)entries.size(), residentBytes / 1048576.0);
+    for (const auto& entry : entries) {
+        TraceLog(LOG_INFO, "TEXTURES:     %4ix%-4i %7.2f MiB  refs %i  %s", entry.texture.width, entry.texture.height,
+            entry.bytes / 1048576.0, entry.references, entry.fileName.c_str());
+    }
+}
@@ -0,0 +1,26 @@
+#pragma once
+#include <raylib.h>
+
+// Textures shared by file path and, for trimmed atlases, frame size. The first acquire uploads the
+// texture (trimmed atlases also get their frame bounds scanned); later acquires of the same path
+// and frame size only add a reference. The texture is unloaded when its last reference is
+// released. Acquiring something another holder already keeps resident never touches the disk or
+// the GPU.
+Texture2D AcquireTexture(const char* fileName);
+Texture2D AcquireAtlas(const char* fileName, int frameWidth, int frameHeight);
+void ReleaseTexture(Texture2D texture);
+
+// A texture as entities and asset sets name it; a zero frame size loads it untrimmed
+struct TextureAsset {
+    const char* fileName;
+    int frameWidth;
+    int frameHeight;
+};
+
+Texture2D AcquireAsset(TextureAsset asset);
+Texture2D FindTexture(const char* fileName);    // resident texture without taking a reference; id 0 if none
+bool IsAssetResident(TextureAsset asset);       // loaded as asked, trimmed with the same frame size or not at all
+
+int GetResidentTextureCount();
+long long GetResidentTextureBytes();    // estimated VRAM of everything resident
+void LogResidentTextures();
@@ -0,0 +1,216 @@
+#include "tilemap.hpp"
+#include "render.hpp"
+#include "perfoverlay.hpp"
+#include "trace.hpp"
+#include <cmath>
+
+static const TileMap* activeTileMap = nullptr;
+
+void SetActiveTileMap(const TileMap* map)
+{
+    activeTileMap = map;
+}
+
+const TileMap* GetActiveTileMap()
+{
+    return (activeTileMap != nullptr && !activeTileMap->IsEmpty()) ? activeTileMap : nullptr;
+}
+
+TileMap::TileMap()
+{
+    columns = 0;
+    rows = 0;
+    tileSize = TILESET_TILE_SIZE;
+}
+
+bool TileMap::Reset(int columns, int rows, int tileSize)
+{
+    bool fits = (columns >= 0 && rows >= 0 && (long long)columns * rows <= MAX_CELLS);
+    if (!fits) {
+        columns = 0;
+        rows = 0;
+    }
+    this->columns = columns;
+    this->rows = rows;
+    this->tileSize = (tileSize > 0) ? tileSize : TILESET_TILE_SIZE;
+
+    size_t cells = (size_t)columns * rows;
+    tiles.assign(cells, (int16_t)NO_TILE);
+    collision.assign((cells + 15) / 16, 0);
+    return fits;
+}
+
+void TileMap::Clear()
+{
+    Reset(0, 0, tileSize);
+}
+
+bool TileMap::IsEmpty() const
+{
+    return columns == 0 || rows == 0;
+}
+
+int TileMap::GetColumns() const
+{
+    return columns;
+}
+
+int TileMap::GetRows() const
+{
+    return rows;
+}
+
+int TileMap::GetTileSize() const
+{
+    return tileSize;
+}
+
+void TileMap::SetTile(int col, int row, int tile, TileCollision kind)
+{
+    if (col < 0 || col >= columns || row < 0 || row >= rows) return;
+    size_t cell = (size_t)row * columns + col;
+    tiles[cell] = (int16_t)tile;
+    uint32_t shift = (uint32_t)(cell & 15) * 2;
+    collision[cell >> 4] = (collision[cell >> 4] & ~(3u << shift)) | ((uint32_t)kind << shift);
+}
+
+int TileMap::GetTile(int col, int row) const
+{
+    if (col < 0 || col >= columns || row < 0 || row >= rows) return NO_TILE;
+    return tiles[(size_t)row * columns + col];
+}
+
+TileCollision TileMap::GetCollision(int col, int row) const
+{
+    if (col < 0 || col >= columns || row < 0 || row >= rows) return TILE_EMPTY;
+    size_t cell = (size_t)row * columns + col;
+    return (TileCollision)((collision[cell >> 4] >> ((cell & 15) * 2)) & 3u);
+}
+
+bool TileMap::IsStandable(int col, int row, bool fallingThrough) const
+{
+    TileCollision kind = GetCollision(col, row);
+    if (kind == TILE_EMPTY || (fallingThrough && kind == TILE_PLATFORM)) return false;
+    // Only the top face of a solid block is a floor
+    return GetCollision(col, row - 1) != TILE_SOLID;
+}
+
+bool TileMap::FindSurface(Rectangle body, bool fallingThrough, TileSurface& surface) const
+{
+    CountPerf(PERF_COLLISION_TESTS);
+    if (IsEmpty()) return false;
+    int row = (int)floorf((body.y + body.height) / tileSize);
+    int firstCol = (int)floorf(body.x / tileSize);
+    int lastCol = (int)floorf((body.x + body.width - 0.01f) / tileSize);
+    if (row < 0 || row >= rows) return false;
+
+    for (int col = firstCol; col <= lastCol; col++) {
+        if (!IsStandable(col, row, fallingThrough)) continue;
+
+        // Only the cells under the body; the run can span the whole level
+        int end = col;
+        while (end < lastCol && IsStandable(end + 1, row, fallingThrough)) end++;
+        int start = col;
+        surface.rect = {(float)(start * tileSize), (float)(row * tileSize), (float)((end - start + 1) * tileSize), (float)tileSize};
+        surface.ground = (GetCollision(col, row) != TILE_PLATFORM);
+        return true;
+    }
+    return false;
+}
+
+Rectangle TileMap::ExtendSurface(Rectangle surface, float reach, bool fallingThrough) const
+{
+    if (IsEmpty()) return surface;
+    int row = (int)floorf(surface.y / tileSize);
+    int start = (int)floorf(surface.x / tileSize);
+    int end = (int)floorf((surface.x + surface.width - 0.01f) / tileSize);
+    int reachCells = (int)ceilf(reach / tileSize);
+    int minCol = (start - reachCells > 0) ? start - reachCells : 0;
+    int maxCol = (end + reachCells < columns - 1) ? end + reachCells : columns - 1;
+    while (start > minCol && IsStandable(start - 1, row, fallingThrough)) start--;
+    while (end < maxCol && IsStandable(end + 1, row, fallingThrough)) end++;
+    return {(float)(start * tileSize), surface.y, (float)((end - start + 1) * tileSize), surface.height};
+}
+
+bool TileMap::FindSolidOverlap(Rectangle area, Rectangle& bounds) const
+{
+    CountPerf(PERF_COLLISION_TESTS);
+    if (IsEmpty() || area.width <= 0.0f || area.height <= 0.0f) return false;
+    int firstCol = (int)floorf(area.x / tileSize);
+    int lastCol = (int)floorf((area.x + area.width - 0.01f) / tileSize);
+    int firstRow = (int)floorf(area.y / tileSize);
+    int lastRow = (int)floorf((area.y + area.height - 0.01f) / tileSize);
+
+    int minCol = columns, maxCol = -1, minRow = rows, maxRow = -1;
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int col = firstCol; col <= lastCol; col++) {
+            if (GetCollision(col, row) != TILE_SOLID) continue;
+            if (col < minCol) minCol = col;
+            if (col > maxCol) maxCol = col;
+            if (row < minRow) minRow = row;
+            if (row > maxRow) maxRow = row;
+        }
+    }
+    if (maxCol < 0) return false;
+    bounds = {(float)(minCol * tileSize), (float)(minRow * tileSize),
+              (float)((maxCol - minCol + 1) * tileSize), (float)((maxRow - minRow + 1) * tileSize)};
+    return true;
+}
+
+void TileMap::EncodeRuns(std::vector<TileRun>& runs) const
+{
+    runs.clear();
+    size_t cells = (size_t)columns * rows;
+    for (size_t cell = 0; cell < cells; cell++) {
+        int16_t tile = tiles[cell];
+        uint8_t kind = (uint8_t)((collision[cell >> 4] >> ((cell & 15) * 2)) & 3u);
+        if (!runs.empty() && runs.back().tile == tile && runs.back().collision == kind) {
+            runs.back().length++;
+        } else {
+            runs.push_back(TileRun{tile, kind, 0, 1});
+        }
+    }
+}
+
+bool TileMap::DecodeRuns(const TileRun* runs, int count)
+{
+    size_t cells = (size_t)columns * rows;
+    size_t cell = 0;
+    for (int i = 0; i < count; i++) {
+        if (runs[i].collision > TILE_SOLID || runs[i].length > cells - cell) return false;
+        for (uint32_t n = 0; n < runs[i].length; n++, cell++) {
+            SetTile((int)(cell % columns), (int)(cell / columns), runs[i].tile, (TileCollision)runs[i].collision);
+        }
+    }
+    return cell == cells;
+}
+
+void TileMap::Draw(Texture2D tileset, Rectangle view) const
+{
+    TRACE_ZONE("TileMap::Draw");
+    if (IsEmpty() || tileset.id == 0) return;
+    int tilesetColumns = tileset.width / TILESET_TILE_SIZE;
+    if (tilesetColumns <= 0) return;
+
+    int firstCol = (int)floorf(view.x / tileSize);
+    int lastCol = (int)floorf((view.x + view.width) / tileSize);
+    int firstRow = (int)floorf(view.y / tileSize);
+    int lastRow = (int)floorf((view.y + view.height) / tileSize);
+    if (firstCol < 0) firstCol = 0;
+    if (firstRow < 0) firstRow = 0;
+    if (lastCol >= columns) lastCol = columns - 1;
+    if (lastRow >= rows) lastRow = rows - 1;
+
+    RenderBackend& gfx = GetRenderBackend();
+    for (int row = firstRow; row <= lastRow; row++) {
+        const int16_t* line = &tiles[(size_t)row * columns];
+        for (int col = firstCol; col <= lastCol; col++) {
+            int tile = line[col];
+            if (tile < 0) continue;
+            Rectangle source = {(float)((tile % tilesetColumns) * TILESET_TILE_SIZE), (float)((tile / tilesetColumns) * TILESET_TILE_SIZE),
+                                (float)TILESET_TILE_SIZE, (float)TILESET_TILE_SIZE};
+            Rectangle dest = {(float)(col * tileSize), (float)(row * tileSize), (float)tileSize, (float)tileSize};
+            gfx.DrawTexturePro(tileset, source, dest, {0, 0}, 0.0f, WHITE);
+        }
+    }
+}
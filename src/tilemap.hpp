@@ -0,0 +1,75 @@
+#pragma once
+#include <raylib.h>
+#include <cstdint>
+#include <vector>
+
+// How a cell collides. Platform cells can be dropped through, ground cells cannot, solid cells
+// also block sideways movement.
+enum TileCollision {
+    TILE_EMPTY,
+    TILE_PLATFORM,
+    TILE_GROUND,
+    TILE_SOLID
+};
+
+// Walkable cells a body is standing on. rect covers only the cells under the body, so the lookup
+// stays O(1) on long runs; edge-aware AI widens it with ExtendSurface as far as it needs to see.
+struct TileSurface {
+    Rectangle rect;
+    bool ground;
+};
+
+// One run of identical cells in row-major order, the on-disk form of a tile map
+struct TileRun {
+    int16_t tile;
+    uint8_t collision;
+    uint8_t reserved;
+    uint32_t length;
+};
+
+// Grid of oak_woods_tileset tiles with a collision layer packed at two bits per cell. Collision
+// queries look up the cells under a body directly instead of scanning every platform, and
+// drawing walks only the rows and columns inside the view.
+class TileMap {
+public:
+    static constexpr int TILESET_TILE_SIZE = 24;    // source tile size in oak_woods_tileset.png
+    static constexpr int NO_TILE = -1;              // collision-only cell, nothing drawn
+    static constexpr long long MAX_CELLS = 1 << 24;
+
+    TileMap();
+    bool Reset(int columns, int rows, int tileSize);    // false (and empty) above MAX_CELLS
+    void Clear();
+    bool IsEmpty() const;
+    int GetColumns() const;
+    int GetRows() const;
+    int GetTileSize() const;
+
+    void SetTile(int col, int row, int tile, TileCollision collision);
+    int GetTile(int col, int row) const;
+    TileCollision GetCollision(int col, int row) const;     // TILE_EMPTY outside the map
+
+    // Surface under the feet of body, if the bottom edge is inside a walkable cell whose top is open
+    bool FindSurface(Rectangle body, bool fallingThrough, TileSurface& surface) const;
+    // surface widened along its walkable run by at most reach on each side
+    Rectangle ExtendSurface(Rectangle surface, float reach, bool fallingThrough) const;
+    // Bounds of the solid cells overlapping area, false if there are none
+    bool FindSolidOverlap(Rectangle area, Rectangle& bounds) const;
+
+    void EncodeRuns(std::vector<TileRun>& runs) const;
+    bool DecodeRuns(const TileRun* runs, int count);
+
+    void Draw(Texture2D tileset, Rectangle view) const;
+
+private:
+    int columns;
+    int rows;
+    int tileSize;
+    std::vector<int16_t> tiles;
+    std::vector<uint32_t> collision;    // 16 cells per word
+
+    bool IsStandable(int col, int row, bool fallingThrough) const;
+};
+
+// Tile map the actors collide against, if the current level has one
+void SetActiveTileMap(const TileMap* map);
+const TileMap* GetActiveTileMap();
@@ -0,0 +1,133 @@
+#include "trace.hpp"
+
+#ifdef GAME_TRACE
+#include <raylib.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+static const int TRACE_CAPACITY = 1 << 16;     // events kept per thread, older ones are overwritten
+static const int TRACE_NAME_LENGTH = 40;
+
+struct TraceEvent {
+    long long startNs;
+    long long durationNs;
+    char name[TRACE_NAME_LENGTH];
+};
+
+// Written only by its own thread. head counts every event ever recorded; a reader copies the last
+// TRACE_CAPACITY of them and then drops the ones the writer lapped while it was copying.
+// Buffers are never freed, so a thread that exited still shows up in later writes.
+struct TraceBuffer {
+    TraceEvent events[TRACE_CAPACITY];
+    std::atomic<unsigned long long> head{0};
+    std::atomic<const char*> threadName{nullptr};
+    int threadId = 0;
+    TraceBuffer* next = nullptr;
+};
+
+static std::atomic<TraceBuffer*> buffers{nullptr};
+static std::atomic<int> nextThreadId{1};
+static const TraceClock::time_point traceEpoch = TraceClock::now();
+static thread_local TraceBuffer* threadBuffer = nullptr;
+
+static TraceBuffer* GetThreadBuffer()
+{
+    if (threadBuffer == nullptr) {
+        TraceBuffer* buffer = new TraceBuffer();
+        buffer->threadId = nextThreadId.fetch_add(1);
+        buffer->next = buffers.load(std::memory_order_relaxed);
+        while (!buffers.compare_exchange_weak(buffer->next, buffer, std::memory_order_release, std::memory_order_relaxed)) {
+        }
+        threadBuffer = buffer;
+    }
+    return threadBuffer;
+}
+
+void TraceRecord(const char* name, TraceClock::time_point start, TraceClock::time_point end)
+{
+    TraceBuffer* buffer = GetThreadBuffer();
+    unsigned long long index = buffer->head.load(std::memory_order_relaxed);
+    TraceEvent& event = buffer->events[index % TRACE_CAPACITY];
+    event.startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(start - traceEpoch).count();
+    event.durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+
+    size_t length = strlen(name);
+    if (length >= TRACE_NAME_LENGTH) {
+        name += length - (TRACE_NAME_LENGTH - 1);
+        length = TRACE_NAME_LENGTH - 1;
+    }
+    memcpy(event.name, name, length);
+    event.name[length] = '\0';
+    buffer->head.store(index + 1, std::memory_order_release);
+}
+
+void TraceSetThreadName(const char* name)
+{
+    GetThreadBuffer()->threadName.store(name, std::memory_order_relaxed);
+}
+
+// Stops at maxLength so a name torn by a concurrent write cannot run past its buffer
+static void WriteJsonString(FILE* file, const char* text, size_t maxLength)
+{
+    fputc('"', file);
+    for (const char* end = text + maxLength; text != end && *text != '\0'; text++) {
+        if (*text == '"' || *text == '\\') fputc('\\', file);
+        fputc(*text, file);
+    }
+    fputc('"', file);
+}
+
+bool WriteTrace(const char* fileName)
+{
+    FILE* file = fopen(fileName, "w");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "TRACE: Could not write '%s'", fileName);
+        return false;
+    }
+
+    fprintf(file, "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [");
+    bool first = true;
+    int written = 0;
+    std::vector<TraceEvent> copy;
+    for (TraceBuffer* buffer = buffers.load(std::memory_order_acquire); buffer != nullptr; buffer = buffer->next) {
+        const char* threadName = buffer->threadName.load(std::memory_order_relaxed);
+        if (threadName != nullptr) {
+            fprintf(file, "%s\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, \"args\": {\"name\": ", first ? "" : ",", buffer->threadId);
+            WriteJsonString(file, threadName, strlen(threadName));
+            fprintf(file, "}}");
+            first = false;
+        }
+
+        unsigned long long head = buffer->head.load(std::memory_order_acquire);
+        unsigned long long begin = (head > TRACE_CAPACITY) ? head - TRACE_CAPACITY : 0;
+        copy.clear();
+        for (unsigned long long i = begin; i < head; i++) {
+            copy.push_back(buffer->events[i % TRACE_CAPACITY]);
+        }
+        // Anything the writer reached since then may have been overwritten mid-copy, including the
+        // slot of event `lapped` itself, which it may be filling in right now
+        std::atomic_thread_fence(std::memory_order_acquire);
+        unsigned long long lapped = buffer->head.load(std::memory_order_relaxed);
+        size_t skip = (lapped + 1 > begin + TRACE_CAPACITY) ? (size_t)(lapped + 1 - begin - TRACE_CAPACITY) : 0;
+        if (skip > copy.size()) skip = copy.size();
+
+        for (size_t i = skip; i < copy.size(); i++) {
+            const TraceEvent& event = copy[i];
+            fprintf(file, "%s\n{\"name\": ", first ? "" : ",");
+            WriteJsonString(file, event.name, TRACE_NAME_LENGTH);
+            fprintf(file, ", \"ph\": \"X\", \"pid\": 1, \"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                    buffer->threadId, event.startNs / 1000.0, event.durationNs / 1000.0);
+            first = false;
+            written++;
+        }
+    }
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    TraceLog(LOG_INFO, "TRACE: Wrote %s (%i events)", fileName, written);
+    return true;
+}
+
+#endif
@@ -0,0 +1,43 @@
+#pragma once
+#include <chrono>
+
+// Timeline capture for hitch analysis, written as Chrome trace JSON (chrome://tracing or
+// ui.perfetto.dev). Only built with -DGAME_TRACE; otherwise every call below is an empty inline
+// and TRACE_ZONE expands to nothing.
+//
+// Each thread records into its own ring of the most recent events without taking a lock, so a
+// write taken right after a hitch holds the seconds leading up to it. Names are copied (long ones
+// keep their tail), so file names of assets being loaded are fine.
+#ifdef GAME_TRACE
+
+using TraceClock = std::chrono::steady_clock;
+
+void TraceRecord(const char* name, TraceClock::time_point start, TraceClock::time_point end);
+void TraceSetThreadName(const char* name);     // literal; shown as the track name
+bool WriteTrace(const char* fileName);          // safe while other threads keep recording
+
+class TraceZone {
+public:
+    explicit TraceZone(const char* name) : name(name), start(TraceClock::now()) {}
+    ~TraceZone() { TraceRecord(name, start, TraceClock::now()); }
+    TraceZone(const TraceZone&) = delete;
+    TraceZone& operator=(const TraceZone&) = delete;
+
+private:
+    const char* name;
+    TraceClock::time_point start;
+};
+
+#define TRACE_ZONE_JOIN2(a, b) a##b
+#define TRACE_ZONE_JOIN(a, b) TRACE_ZONE_JOIN2(a, b)
+#define TRACE_ZONE(name) TraceZone TRACE_ZONE_JOIN(traceZone, __LINE__)(name)
+
+#else
+
+inline void TraceRecord(const char*, std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point) {}
+inline void TraceSetThreadName(const char*) {}
+inline bool WriteTrace(const char*) { return false; }
+
+#define TRACE_ZONE(name) ((void)0)
+
+#endif
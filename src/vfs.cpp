@@ -0,0 +1,206 @@
+#if defined(_WIN32)
+    // Keep windows.h from declaring names raylib also uses (Rectangle, CloseWindow, DrawText...)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOGDI
+    #define NOUSER
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+#include "vfs.hpp"
+#include "pack.hpp"
+#include <raylib.h>
+#include <cstdio>
+#include <cstring>
+
+static const unsigned char* mapping = nullptr;
+static size_t mappingSize = 0;
+static const PackHeader* header = nullptr;
+static const PackSlot* slots = nullptr;
+static const char* names = nullptr;
+#if defined(_WIN32)
+static HANDLE fileHandle = INVALID_HANDLE_VALUE;
+static HANDLE mappingHandle = NULL;
+#endif
+
+static bool MapFile(const char* fileName)
+{
+#if defined(_WIN32)
+    fileHandle = CreateFileA(fileName, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart == 0) {
+        CloseHandle(fileHandle);
+        fileHandle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = (mappingHandle != NULL) ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : NULL;
+    if (view == NULL) {
+        if (mappingHandle != NULL) CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        mappingHandle = NULL;
+        fileHandle = INVALID_HANDLE_VALUE;
+        return false;
+    }
+    mapping = (const unsigned char*)view;
+    mappingSize = (size_t)size.QuadPart;
+#else
+    int fd = open(fileName, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        return false;
+    }
+    void* view = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);      // the mapping keeps the file alive
+    if (view == MAP_FAILED) return false;
+    // Assets are laid out in load order, so let the kernel read ahead
+    madvise(view, (size_t)info.st_size, MADV_SEQUENTIAL);
+    mapping = (const unsigned char*)view;
+    mappingSize = (size_t)info.st_size;
+#endif
+    return true;
+}
+
+static void UnmapFile()
+{
+    if (mapping == nullptr) return;
+#if defined(_WIN32)
+    UnmapViewOfFile(mapping);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+    mappingHandle = NULL;
+    fileHandle = INVALID_HANDLE_VALUE;
+#else
+    munmap((void*)mapping, mappingSize);
+#endif
+    mapping = nullptr;
+    mappingSize = 0;
+}
+
+static const PackSlot* FindSlot(const char* fileName)
+{
+    if (header == nullptr) return nullptr;
+    size_t length = strlen(fileName);
+    uint64_t hash = HashPackPath(fileName, length);
+    uint32_t mask = header->slotCount - 1;
+    // A full table (only a damaged or foreign pack has one) would otherwise probe forever
+    uint32_t i = (uint32_t)hash & mask;
+    for (uint32_t probes = 0; probes < header->slotCount && slots[i].hash != 0; probes++, i = (i + 1) & mask) {
+        const PackSlot& slot = slots[i];
+        if (slot.hash == hash && slot.nameLength == length && PackPathsEqual(names + slot.nameOffset, fileName, length)) {
+            return &slot;
+        }
+    }
+    return nullptr;
+}
+
+static unsigned char* ReadDiskFile(const char* fileName, int* dataSize)
+{
+    *dataSize = 0;
+    FILE* file = fopen(fileName, "rb");
+    if (file == NULL) {
+        TraceLog(LOG_WARNING, "FILEIO: [%s] Failed to open file", fileName);
+        return NULL;
+    }
+    fseek(file, 0, SEEK_END);
+    long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    unsigned char* data = (size > 0) ? (unsigned char*)MemAlloc((unsigned int)size) : NULL;
+    if (data != NULL && fread(data, 1, (size_t)size, file) == (size_t)size) {
+        *dataSize = (int)size;
+    } else if (data != NULL) {
+        MemFree(data);
+        data = NULL;
+    }
+    fclose(file);
+    return data;
+}
+
+// raylib frees what this returns, so packed assets are copied out of the mapping
+static unsigned char* LoadAssetData(const char* fileName, int* dataSize)
+{
+    size_t size = 0;
+    const unsigned char* packed = GetPackedAsset(fileName, &size);
+    if (packed == nullptr) return ReadDiskFile(fileName, dataSize);
+
+    unsigned char* data = (unsigned char*)MemAlloc((unsigned int)size);
+    if (data == NULL) {
+        *dataSize = 0;
+        return NULL;
+    }
+    memcpy(data, packed, size);
+    *dataSize = (int)size;
+    return data;
+}
+
+bool MountAssetPack(const char* packFile)
+{
+    UnmountAssetPack();
+    if (!MapFile(packFile)) {
+        TraceLog(LOG_INFO, "VFS: No asset pack at '%s', reading loose files", packFile);
+        return false;
+    }
+
+    const PackHeader* candidate = (const PackHeader*)mapping;
+    bool valid = mappingSize >= sizeof(PackHeader) && candidate->magic == PACK_MAGIC && candidate->version == PACK_VERSION &&
+                 candidate->slotCount != 0 && (candidate->slotCount & (candidate->slotCount - 1)) == 0;
+    if (valid) {
+        uint64_t slotsEnd = sizeof(PackHeader) + (uint64_t)candidate->slotCount * sizeof(PackSlot);
+        valid = slotsEnd <= mappingSize && candidate->namesOffset <= mappingSize && candidate->namesSize <= mappingSize - candidate->namesOffset;
+    }
+    // Every slot once here, so lookups can trust name and data ranges without checking again
+    const PackSlot* candidateSlots = (const PackSlot*)(mapping + sizeof(PackHeader));
+    for (uint32_t i = 0; valid && i < candidate->slotCount; i++) {
+        const PackSlot& slot = candidateSlots[i];
+        if (slot.hash == 0) continue;
+        valid = (uint64_t)slot.nameOffset + slot.nameLength <= candidate->namesSize &&
+                slot.offset <= mappingSize && slot.size <= mappingSize - slot.offset;
+    }
+    if (!valid) {
+        TraceLog(LOG_WARNING, "VFS: '%s' is not a version %u asset pack", packFile, PACK_VERSION);
+        UnmapFile();
+        return false;
+    }
+
+    header = candidate;
+    slots = (const PackSlot*)(mapping + sizeof(PackHeader));
+    names = (const char*)(mapping + header->namesOffset);
+    SetLoadFileDataCallback(LoadAssetData);
+    TraceLog(LOG_INFO, "VFS: Mounted '%s' (%u assets, %.2f MiB)", packFile, header->entryCount, mappingSize / 1048576.0);
+    return true;
+}
+
+void UnmountAssetPack()
+{
+    if (mapping == nullptr) return;
+    SetLoadFileDataCallback(NULL);
+    header = nullptr;
+    slots = nullptr;
+    names = nullptr;
+    UnmapFile();
+}
+
+bool IsAssetPackMounted()
+{
+    return header != nullptr;
+}
+
+bool AssetExists(const char* fileName)
+{
+    return FindSlot(fileName) != nullptr || FileExists(fileName);
+}
+
+const unsigned char* GetPackedAsset(const char* fileName, size_t* size)
+{
+    const PackSlot* slot = FindSlot(fileName);
+    if (slot == nullptr) return nullptr;
+    *size = (size_t)slot->size;
+    return mapping + slot->offset;
+}
@@ -0,0 +1,15 @@
+#pragma once
+#include <cstddef>
+
+// Asset files served from the packed archive (see pack.hpp) when one is mounted, from disk
+// otherwise. Mounting maps the archive once and installs raylib's file-data callback, so
+// LoadImage, LoadFontEx, LoadSound and friends read through it with no change at the call sites.
+bool MountAssetPack(const char* packFile);
+void UnmountAssetPack();
+bool IsAssetPackMounted();
+
+bool AssetExists(const char* fileName);
+
+// Bytes of a packed asset, read in place from the mapping (valid until unmount); null if the
+// asset is not in the archive
+const unsigned char* GetPackedAsset(const char* fileName, size_t* size);
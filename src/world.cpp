@@ -0,0 +1,67 @@
+#include "world.hpp"
+
+static float worldWidth = 0.0f;
+static float worldHeight = 0.0f;
+static Rectangle worldView = {0, 0, 0, 0};
+static int viewWidth = 0;
+static int viewHeight = 0;
+
+void SetWorldSize(float width, float height)
+{
+    worldWidth = width;
+    worldHeight = height;
+}
+
+float GetWorldWidth()
+{
+    return (worldWidth > 0.0f) ? worldWidth : (float)GetViewWidth();
+}
+
+float GetWorldHeight()
+{
+    return (worldHeight > 0.0f) ? worldHeight : (float)GetViewHeight();
+}
+
+Rectangle GetWorldBounds()
+{
+    return Rectangle{0, 0, GetWorldWidth(), GetWorldHeight()};
+}
+
+void SetViewSize(int width, int height)
+{
+    viewWidth = width;
+    viewHeight = height;
+}
+
+int GetViewWidth()
+{
+    return (viewWidth > 0) ? viewWidth : GetScreenWidth();
+}
+
+int GetViewHeight()
+{
+    return (viewHeight > 0) ? viewHeight : GetScreenHeight();
+}
+
+void SetWorldView(Rectangle view)
+{
+    worldView = view;
+}
+
+Rectangle GetWorldView()
+{
+    if (worldView.width <= 0.0f || worldView.height <= 0.0f) {
+        return Rectangle{0, 0, (float)GetViewWidth(), (float)GetViewHeight()};
+    }
+    return worldView;
+}
+
+bool IsInWorldView(Rectangle rect, float margin)
+{
+    Rectangle view = GetWorldView();
+    view.x -= margin;
+    view.y -= margin;
+    view.width += margin * 2.0f;
+    view.height += margin * 2.0f;
+    return CheckCollisionRecs(rect, view);
+}
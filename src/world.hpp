@@ -0,0 +1,20 @@
+#pragma once
+#include <raylib.h>
+
+// Playable area in world coordinates, spanning (0,0) to (width,height). Entities clamp and stick
+// to it instead of the screen. Defaults to the screen size until a level sets it.
+void SetWorldSize(float width, float height);
+float GetWorldWidth();
+float GetWorldHeight();
+Rectangle GetWorldBounds();
+
+// Layout resolution the game is authored in (screen-space UI and the camera view). The frame may be
+// rendered at a different size and is scaled to the window. Defaults to the screen size.
+void SetViewSize(int width, int height);
+int GetViewWidth();
+int GetViewHeight();
+
+// Region of the world currently on screen, updated by the camera each frame
+void SetWorldView(Rectangle view);
+Rectangle GetWorldView();
+bool IsInWorldView(Rectangle rect, float margin = 0.0f);
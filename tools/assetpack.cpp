@@ -0,0 +1,148 @@
+// Builds the asset archive the game mounts at startup (format in src/pack.hpp).
+//
+//   assetpack <output.pak> <source dir> [extra asset...]
+//
+// Only assets the game references are packed: every "resources/..." string literal found in the
+// sources, plus any extra paths given. Files are written in the order main.cpp first mentions
+// them (then the other sources), which is roughly the order they load, so a cold start reads the
+// archive front to back. Run it from the repository root so the paths resolve.
+#include "../src/pack.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static void CollectLiterals(const fs::path& source, std::vector<std::string>& assets)
+{
+    std::ifstream file(source, std::ios::binary);
+    std::stringstream text;
+    text << file.rdbuf();
+    const std::string content = text.str();
+
+    const std::string prefix = "\"resources/";
+    for (size_t start = content.find(prefix); start != std::string::npos; start = content.find(prefix, start + 1)) {
+        size_t end = content.find('"', start + 1);
+        if (end == std::string::npos) break;
+        std::string path = content.substr(start + 1, end - start - 1);
+        if (std::find(assets.begin(), assets.end(), path) == assets.end()) {
+            assets.push_back(path);
+        }
+    }
+}
+
+static bool WritePadding(FILE* out, uint64_t from, uint64_t to)
+{
+    static const char zeros[PACK_ALIGNMENT] = {0};
+    return to <= from || fwrite(zeros, 1, (size_t)(to - from), out) == to - from;
+}
+
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <output.pak> <source dir> [extra asset...]\n", argv[0]);
+        return 1;
+    }
+
+    // main.cpp holds the startup lists, so its order comes first
+    std::vector<fs::path> sources;
+    for (const auto& item : fs::directory_iterator(argv[2])) {
+        std::string ext = item.path().extension().string();
+        if (ext == ".cpp" || ext == ".hpp" || ext == ".h") sources.push_back(item.path());
+    }
+    std::sort(sources.begin(), sources.end(), [](const fs::path& a, const fs::path& b) {
+        bool aMain = a.filename() == "main.cpp";
+        bool bMain = b.filename() == "main.cpp";
+        return (aMain != bMain) ? aMain : a < b;
+    });
+
+    std::vector<std::string> referenced;
+    for (const auto& source : sources) {
+        CollectLiterals(source, referenced);
+    }
+    for (int i = 3; i < argc; i++) {
+        if (std::find(referenced.begin(), referenced.end(), argv[i]) == referenced.end()) referenced.push_back(argv[i]);
+    }
+
+    // Referenced paths with no file behind them are optional (the game has fallbacks) or typos
+    std::vector<std::string> assets;
+    for (const auto& path : referenced) {
+        if (fs::is_regular_file(path)) assets.push_back(path);
+        else printf("skip   %s (not found)\n", path.c_str());
+    }
+
+    uint32_t slotCount = 1;
+    while (slotCount < assets.size() * 2) slotCount <<= 1;
+    std::vector<PackSlot> slots(slotCount, PackSlot{0, 0, 0, 0, 0});
+
+    std::string names;
+    for (const auto& path : assets) {
+        names += path;
+    }
+
+    PackHeader header;
+    header.magic = PACK_MAGIC;
+    header.version = PACK_VERSION;
+    header.slotCount = slotCount;
+    header.entryCount = (uint32_t)assets.size();
+    header.namesOffset = sizeof(PackHeader) + slotCount * sizeof(PackSlot);
+    header.namesSize = names.size();
+
+    // Lay out the data first so every slot knows its offset
+    uint64_t offset = AlignPackOffset(header.namesOffset + header.namesSize);
+    uint32_t nameOffset = 0;
+    std::vector<uint64_t> offsets;
+    for (const auto& path : assets) {
+        uint64_t size = fs::file_size(path);
+        uint64_t hash = HashPackPath(path.c_str(), path.size());
+        uint32_t index = (uint32_t)hash & (slotCount - 1);
+        while (slots[index].hash != 0) index = (index + 1) & (slotCount - 1);
+        slots[index] = PackSlot{hash, nameOffset, (uint32_t)path.size(), offset, size};
+
+        offsets.push_back(offset);
+        nameOffset += (uint32_t)path.size();
+        offset = AlignPackOffset(offset + size);
+    }
+
+    FILE* out = fopen(argv[1], "wb");
+    if (out == NULL) {
+        fprintf(stderr, "cannot write %s\n", argv[1]);
+        return 1;
+    }
+    bool ok = fwrite(&header, sizeof(header), 1, out) == 1 &&
+              fwrite(slots.data(), sizeof(PackSlot), slots.size(), out) == slots.size() &&
+              fwrite(names.data(), 1, names.size(), out) == names.size();
+    uint64_t written = header.namesOffset + header.namesSize;
+
+    std::vector<char> buffer;
+    for (size_t i = 0; ok && i < assets.size(); i++) {
+        ok = WritePadding(out, written, offsets[i]);
+        std::ifstream file(assets[i], std::ios::binary);
+        buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        ok = ok && fwrite(buffer.data(), 1, buffer.size(), out) == buffer.size();
+        written = offsets[i] + buffer.size();
+        printf("pack   %10zu  %s\n", buffer.size(), assets[i].c_str());
+    }
+    ok = ok && WritePadding(out, written, AlignPackOffset(written));
+    ok = (fclose(out) == 0) && ok;
+    if (!ok) {
+        fprintf(stderr, "failed writing %s\n", argv[1]);
+        return 1;
+    }
+
+    // Loose files under resources/ that nothing references stay out of the archive
+    size_t unreferenced = 0;
+    std::error_code error;
+    for (const auto& item : fs::recursive_directory_iterator("resources", error)) {
+        if (!item.is_regular_file()) continue;
+        std::string path = item.path().generic_string();
+        if (std::find(assets.begin(), assets.end(), path) == assets.end()) unreferenced++;
+    }
+    printf("%zu assets, %.2f MiB written to %s (%zu unreferenced files left out)\n",
+           assets.size(), AlignPackOffset(written) / 1048576.0, argv[1], unreferenced);
+    return 0;
+}
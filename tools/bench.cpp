@@ -0,0 +1,296 @@
+// Microbenchmarks for the engine's per-frame hot paths, built on microbench.hpp.
+//
+//   bench [--filter=<text>] [--samples=<n>] [--min-sample-ms=<ms>] [--json=<file>]
+//
+// Runs on the null render backend, so no window or GPU is needed, but the actors load their
+// sprite sheets: run it from the repository root. It links every game source except main.cpp
+// (see the "build benchmarks" task). Scenes are built deterministically so numbers from two
+// builds can be compared; the JSON output carries the date and compiler of each run.
+#include "microbench.hpp"
+#include "../src/animation.h"
+#include "../src/bringerofdeath.hpp"
+#include "../src/enemy.hpp"
+#include "../src/fighter.hpp"
+#include "../src/huntress.hpp"
+#include "../src/mushroom.hpp"
+#include "../src/particles.hpp"
+#include "../src/platform.hpp"
+#include "../src/render.hpp"
+#include "../src/sfx.hpp"
+#include "../src/slime.hpp"
+#include "../src/textures.hpp"
+#include "../src/vfs.hpp"
+#include "../src/world.hpp"
+#include <raylib.h>
+#include <string>
+#include <vector>
+
+static const int PLATFORM_COUNTS[] = {16, 256, 4096};
+static const int SPEAR_COUNTS[] = {16, 256, 4096};
+static const int ENEMY_COUNTS[] = {16, 256, 1024};
+static const float WORLD_WIDTH = 7680.0f;
+
+// Friend of the actor classes: the collision and spear helpers are private
+struct BenchAccess {
+    static bool PlatformCollision(Fighter& actor, const std::vector<Platform>& platforms) { return actor.CheckPlatformCollision(platforms); }
+    static bool PlatformCollision(Mushroom& actor, const std::vector<Platform>& platforms) { return actor.CheckPlatformCollision(platforms); }
+    static bool PlatformCollision(Slime& actor, const std::vector<Platform>& platforms) { return actor.CheckPlatformCollision(platforms); }
+    static bool PlatformCollision(Boss& actor, const std::vector<Platform>& platforms) { return actor.CheckPlatformCollision(platforms); }
+    static bool PlatformCollision(Huntress& actor, const std::vector<Platform>& platforms)
+    {
+        Rectangle hit;
+        return actor.CheckPlatformCollision(platforms, &hit);
+    }
+
+    static std::vector<Spear>& Spears(Huntress& huntress) { return huntress.spears; }
+
+    static void UpdateSpear(Huntress& huntress, const std::vector<Platform>& platforms, const std::vector<Wall>& walls, const Fighter& player)
+    {
+        huntress.UpdateSpear(platforms, walls, player);
+    }
+};
+
+// Fixed-seed LCG so every run builds the same scenes
+static unsigned int benchSeed = 12345;
+static float BenchRandom(float low, float high)
+{
+    benchSeed = benchSeed * 1664525u + 1013904223u;
+    return low + (high - low) * (float)(benchSeed >> 8) / (float)(1u << 24);
+}
+
+// Platforms high above every actor: nothing lands, so each check scans the whole list
+static std::vector<Platform> MakeFloatingPlatforms(int count)
+{
+    std::vector<Platform> platforms;
+    platforms.reserve(count);
+    for (int i = 0; i < count; i++) {
+        platforms.emplace_back(BenchRandom(0.0f, WORLD_WIDTH - 400.0f), BenchRandom(60.0f, 300.0f), BenchRandom(120.0f, 400.0f), 30.0f);
+    }
+    return platforms;
+}
+
+static std::vector<Wall> MakeWalls(int count)
+{
+    std::vector<Wall> walls;
+    for (int i = 0; i < count; i++) {
+        walls.emplace_back(1000.0f + i * (WORLD_WIDTH - 1200.0f) / count, 960.0f, 60.0f, 120.0f);
+    }
+    return walls;
+}
+
+// Enemies spread across the level, away from the fighter's start, in a fixed kind order
+static std::vector<Enemy*> MakeEnemies(int count)
+{
+    std::vector<Enemy*> enemies;
+    for (int i = 0; i < count; i++) {
+        Vector2 position = {1200.0f + BenchRandom(0.0f, WORLD_WIDTH - 1600.0f), 500.0f};
+        switch (i % 3) {
+            case 0: enemies.push_back(new Mushroom(position)); break;
+            case 1: enemies.push_back(new Slime(position)); break;
+            default: enemies.push_back(new Huntress(position)); break;
+        }
+    }
+    return enemies;
+}
+
+static void FreeEnemies(std::vector<Enemy*>& enemies)
+{
+    for (Enemy* enemy : enemies) delete enemy;
+    enemies.clear();
+}
+
+template <typename Actor>
+static void BenchPlatformCollision(microbench::Runner& runner, const char* actorName, Actor& actor)
+{
+    for (int count : PLATFORM_COUNTS) {
+        std::vector<Platform> platforms = MakeFloatingPlatforms(count);
+        runner.Run(std::string("CheckPlatformCollision/") + actorName + "/" + std::to_string(count), [&](long long iterations) {
+            for (long long i = 0; i < iterations; i++) {
+                microbench::DoNotOptimize(BenchAccess::PlatformCollision(actor, platforms));
+            }
+        });
+    }
+}
+
+static void BenchCollisions(microbench::Runner& runner)
+{
+    Fighter fighter;
+    Mushroom mushroom({400.0f, 500.0f});
+    Slime slime({400.0f, 500.0f});
+    Huntress huntress({400.0f, 500.0f});
+    Boss boss({400.0f, 500.0f});
+    BenchPlatformCollision(runner, "Fighter", fighter);
+    BenchPlatformCollision(runner, "Mushroom", mushroom);
+    BenchPlatformCollision(runner, "Slime", slime);
+    BenchPlatformCollision(runner, "Huntress", huntress);
+    BenchPlatformCollision(runner, "Boss", boss);
+}
+
+static void BenchAnimations(microbench::Runner& runner)
+{
+    Texture2D trimmedSheet = AcquireAtlas("resources/char_red_1.png", 56, 56);
+    Texture2D plainSheet = AcquireTexture("resources/char_red_2.png");
+    AtlasInfo atlas = {56, 56, trimmedSheet.width / 56};
+    AtlasInfo plainAtlas = {56, 56, plainSheet.width / 56};
+
+    spriteAnimation looped = LoadAnim(run, trimmedSheet, atlas, true);
+    spriteAnimation clamped = LoadAnim(death, trimmedSheet, atlas, false);
+    spriteAnimation untrimmed = LoadAnim(run, plainSheet, plainAtlas, true);
+    Rectangle dest = {400.0f, 600.0f, 196.0f, 196.0f};
+
+    // Frame index and trimmed-rect math; the draw itself lands in the null backend
+    runner.Run("DrawSpriteAnimationPro/loop-trimmed", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++) {
+            DrawSpriteAnimationPro(looped, dest, {0, 0}, 0.0f, WHITE, (i & 1) != 0, (float)(i & 1023) * 0.0167f);
+        }
+    });
+    runner.Run("DrawSpriteAnimationPro/clamp-trimmed", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++) {
+            DrawSpriteAnimationPro(clamped, dest, {0, 0}, 0.0f, WHITE, (i & 1) != 0, (float)(i & 255) * 0.0167f);
+        }
+    });
+    runner.Run("DrawSpriteAnimationPro/loop-untrimmed", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++) {
+            DrawSpriteAnimationPro(untrimmed, dest, {0, 0}, 0.0f, WHITE, (i & 1) != 0, (float)(i & 1023) * 0.0167f);
+        }
+    });
+    runner.Run("GetSpriteAnimationBox/loop-trimmed", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++) {
+            microbench::DoNotOptimize(GetSpriteAnimationBox(looped, dest, (i & 1) != 0, (float)(i & 1023) * 0.0167f));
+        }
+    });
+
+    runner.Run("LoadAnim/trimmed", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++) {
+            spriteAnimation animation = LoadAnim(run, trimmedSheet, atlas, true);
+            microbench::DoNotOptimize(animation);
+            DisposeSpriteAnimation(animation);
+        }
+    });
+    runner.Run("LoadAnim/untrimmed", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++) {
+            spriteAnimation animation = LoadAnim(run, plainSheet, plainAtlas, true);
+            microbench::DoNotOptimize(animation);
+            DisposeSpriteAnimation(animation);
+        }
+    });
+    Rectangle frames[8];
+    for (int i = 0; i < 8; i++) {
+        frames[i] = Rectangle{(float)(i * 56), 0.0f, 56.0f, 56.0f};
+    }
+    runner.Run("CreateSpriteAnimation/8", [&](long long iterations) {
+        for (long long i = 0; i < iterations; i++) {
+            spriteAnimation animation = CreateSpriteAnimation(plainSheet, 10, frames, 8, true);
+            microbench::DoNotOptimize(animation);
+            DisposeSpriteAnimation(animation);
+        }
+    });
+
+    DisposeSpriteAnimation(looped);
+    DisposeSpriteAnimation(clamped);
+    DisposeSpriteAnimation(untrimmed);
+    ReleaseTexture(trimmedSheet);
+    ReleaseTexture(plainSheet);
+}
+
+static void BenchSpears(microbench::Runner& runner)
+{
+    Fighter player;
+    Huntress huntress({400.0f, 500.0f});
+    std::vector<Platform> platforms = MakeFloatingPlatforms(64);
+    std::vector<Wall> walls = MakeWalls(8);
+
+    for (int count : SPEAR_COUNTS) {
+        // Parked between the platforms and the walls, clear of the player: none hit, so the
+        // set stays the same from one iteration to the next
+        std::vector<Spear>& spears = BenchAccess::Spears(huntress);
+        spears.clear();
+        for (int i = 0; i < count; i++) {
+            spears.push_back(Spear{{BenchRandom(1000.0f, WORLD_WIDTH - 200.0f), 420.0f}, 0.0f, 32.0f, 8.0f, true});
+        }
+        runner.Run("Huntress::UpdateSpear/" + std::to_string(count), [&](long long iterations) {
+            for (long long i = 0; i < iterations; i++) {
+                BenchAccess::UpdateSpear(huntress, platforms, walls, player);
+            }
+        });
+    }
+    BenchAccess::Spears(huntress).clear();
+}
+
+static void BenchEnemyScans(microbench::Runner& runner, NullRenderBackend& backend)
+{
+    Fighter fighter;
+    std::vector<Platform> platforms = MakeFloatingPlatforms(64);
+    platforms.emplace_back(0.0f, 1000.0f, WORLD_WIDTH, 80.0f, true);
+    std::vector<Wall> walls = MakeWalls(8);
+
+    for (int count : ENEMY_COUNTS) {
+        std::string suffix = "/" + std::to_string(count);
+        bool wanted = runner.Selected("Fighter::characterDeath" + suffix) || runner.Selected("Enemy::allEnemiesDefeated/alive" + suffix) ||
+                      runner.Selected("Enemy::allEnemiesDefeated/dead" + suffix);
+        if (!wanted) continue;
+        std::vector<Enemy*> enemies = MakeEnemies(count);
+        for (Enemy* enemy : enemies) {
+            Huntress* huntress = dynamic_cast<Huntress*>(enemy);
+            if (huntress == nullptr) continue;
+            for (int i = 0; i < 4; i++) {
+                BenchAccess::Spears(*huntress).push_back(Spear{{BenchRandom(2000.0f, WORLD_WIDTH - 200.0f), 420.0f}, 0.0f, 32.0f, 8.0f, true});
+            }
+        }
+
+        // Nobody touches the fighter, so every call walks all three enemy passes
+        runner.Run("Fighter::characterDeath" + suffix, [&](long long iterations) {
+            for (long long i = 0; i < iterations; i++) {
+                fighter.characterDeath(enemies);
+            }
+        });
+        runner.Run("Enemy::allEnemiesDefeated/alive" + suffix, [&](long long iterations) {
+            for (long long i = 0; i < iterations; i++) {
+                microbench::DoNotOptimize(Enemy::allEnemiesDefeated(enemies));
+            }
+        });
+
+        // Worst case: every enemy has finished dying, so the whole list is checked
+        for (Enemy* enemy : enemies) {
+            enemy->TakeDamage(1000000.0f);
+        }
+        for (int frame = 0; frame < 1200 && !Enemy::allEnemiesDefeated(enemies); frame++) {
+            for (Enemy* enemy : enemies) {
+                if (!enemy->IsDead()) enemy->Update(platforms, walls, fighter);
+            }
+            UpdateParticles(GetGameFrameTime());
+            backend.EndDrawing();
+        }
+        runner.Run("Enemy::allEnemiesDefeated/dead" + suffix, [&](long long iterations) {
+            for (long long i = 0; i < iterations; i++) {
+                microbench::DoNotOptimize(Enemy::allEnemiesDefeated(enemies));
+            }
+        });
+        FreeEnemies(enemies);
+        ClearParticles();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    SetTraceLogLevel(LOG_WARNING);
+    MountAssetPack("resources.pak");
+
+    NullRenderBackend backend;
+    SetRenderBackend(&backend);
+    SetViewSize(1920, 1080);
+    SetWorldSize(WORLD_WIDTH, 1080.0f);
+    InitParticles(0);
+    InitSfx(24);
+
+    microbench::Runner runner(argc, argv);
+    BenchCollisions(runner);
+    BenchAnimations(runner);
+    BenchSpears(runner);
+    BenchEnemyScans(runner, backend);
+    bool written = runner.Finish();
+
+    UnloadParticles();
+    UnmountAssetPack();
+    return written ? 0 : 1;
+}
@@ -0,0 +1,135 @@
+#pragma once
+// Header-only microbenchmark harness for the tools in this directory. No dependencies beyond the
+// standard library, so it builds anywhere the game does.
+//
+// Each benchmark is a callable taking an iteration count and running the measured operation that
+// many times. The runner grows the count until one sample takes at least minSampleMs, then takes
+// `samples` samples and reports nanoseconds per operation (min, median, mean, max). Results are
+// printed as a table and, with --json=<file>, written as JSON so runs can be compared over time.
+//
+//   --filter=<text>        only run benchmarks whose name contains text
+//   --samples=<n>          samples per benchmark (default 11)
+//   --min-sample-ms=<ms>   minimum duration of one sample (default 5)
+//   --json=<file>          machine-readable results
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace microbench {
+
+// Keeps the compiler from discarding a result it can prove unused
+template <typename T>
+inline void DoNotOptimize(const T& value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+inline void ClobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+struct Result {
+    std::string name;
+    long long iterations;   // per sample
+    int samples;
+    double minNs;
+    double medianNs;
+    double meanNs;
+    double maxNs;
+};
+
+class Runner {
+public:
+    Runner(int argc, char** argv)
+    {
+        for (int i = 1; i < argc; i++) {
+            const char* arg = argv[i];
+            if (strncmp(arg, "--filter=", 9) == 0) filter = arg + 9;
+            else if (strncmp(arg, "--samples=", 10) == 0) samples = std::max(1, atoi(arg + 10));
+            else if (strncmp(arg, "--min-sample-ms=", 16) == 0) minSampleMs = std::max(0.01, atof(arg + 16));
+            else if (strncmp(arg, "--json=", 7) == 0) jsonFile = arg + 7;
+            else fprintf(stderr, "microbench: unknown argument '%s'\n", arg);
+        }
+        printf("%-52s %12s %12s %12s %12s\n", "benchmark", "min ns", "median ns", "max ns", "iterations");
+    }
+
+    bool Selected(const std::string& name) const
+    {
+        return filter.empty() || name.find(filter) != std::string::npos;
+    }
+
+    template <typename Body>
+    void Run(const std::string& name, Body&& body)
+    {
+        if (!Selected(name)) return;
+
+        long long iterations = 1;
+        for (;;) {
+            double ms = Time(body, iterations) / 1e6;
+            if (ms >= minSampleMs || iterations >= (1LL << 40)) break;
+            // Aim a little past the target so the next try usually settles it
+            double scale = (ms > 0.0) ? 1.2 * minSampleMs / ms : 10.0;
+            iterations = (long long)(iterations * std::min(std::max(scale, 2.0), 10.0));
+        }
+
+        std::vector<double> perOp;
+        for (int s = 0; s < samples; s++) {
+            perOp.push_back(Time(body, iterations) / (double)iterations);
+        }
+        std::sort(perOp.begin(), perOp.end());
+        double sum = 0.0;
+        for (double ns : perOp) sum += ns;
+        Result result = {name, iterations, samples, perOp.front(), perOp[perOp.size() / 2], sum / perOp.size(), perOp.back()};
+        results.push_back(result);
+        printf("%-52s %12.2f %12.2f %12.2f %12lld\n", name.c_str(), result.minNs, result.medianNs, result.maxNs, iterations);
+        fflush(stdout);
+    }
+
+    // Writes the JSON report if one was asked for; returns false if it could not be written
+    bool Finish() const
+    {
+        if (jsonFile.empty()) return true;
+        FILE* file = fopen(jsonFile.c_str(), "w");
+        if (file == NULL) {
+            fprintf(stderr, "microbench: could not write '%s'\n", jsonFile.c_str());
+            return false;
+        }
+        char date[32];
+        time_t now = time(NULL);
+        strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+        fprintf(file, "{\n  \"date\": \"%s\",\n  \"compiler\": \"%s\",\n  \"samples\": %d,\n  \"minSampleMs\": %.3f,\n  \"benchmarks\": [",
+                date, __VERSION__, samples, minSampleMs);
+        for (size_t i = 0; i < results.size(); i++) {
+            const Result& r = results[i];
+            fprintf(file, "%s\n    {\"name\": \"%s\", \"iterations\": %lld, \"samples\": %d, \"minNs\": %.3f, \"medianNs\": %.3f, \"meanNs\": %.3f, \"maxNs\": %.3f}",
+                    (i == 0) ? "" : ",", r.name.c_str(), r.iterations, r.samples, r.minNs, r.medianNs, r.meanNs, r.maxNs);
+        }
+        fprintf(file, "\n  ]\n}\n");
+        fclose(file);
+        return true;
+    }
+
+private:
+    std::string filter;
+    std::string jsonFile;
+    int samples = 11;
+    double minSampleMs = 5.0;
+    std::vector<Result> results;
+
+    template <typename Body>
+    static double Time(Body& body, long long iterations)
+    {
+        auto start = std::chrono::steady_clock::now();
+        body(iterations);
+        ClobberMemory();
+        return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    }
+};
+
+}